@@ -17,6 +17,8 @@
 #include <unordered_map>
 #include <SFML/Graphics.hpp>
 #include "../../scripts/Helper.h"
+#include "../../scripts/ItemStore.h"
+#include "../../scripts/TagIndex.h"
 #include <variant>
 #include <string>
 
@@ -175,6 +177,52 @@ public:
 
 };
 
+// --- TagQueryCommand ---
+// Lists the items whose tags match a boolean query, e.g. "/tags weapon AND rare".
+class TagQueryCommand : public Command {
+private:
+    const ItemStore& items;  // Catalog the names are read from
+    const TagIndex& index;   // Tag index built over the same catalog
+    static constexpr std::size_t MAX_LISTED = 10;  // Names printed before summarizing the rest
+
+public:
+    // Constructor sets the prefix to "/tags"
+    TagQueryCommand(const ItemStore& items, const TagIndex& index) : Command("/tags"), items(items), index(index) {}
+
+    // Execute command: Evaluates the query typed after the prefix
+    void execute(std::vector<std::string>& consoleLines) override {
+        const std::string& line = consoleLines[consoleLines.size() - 1];
+        std::size_t space = line.find(' ');
+        std::string query = space == std::string::npos ? "" : trim(line.substr(space + 1));
+        if (query.empty()) {
+            consoleLines.emplace_back("Usage: /tags <query>, e.g. /tags weapon AND NOT common");
+            return;
+        }
+
+        RoaringBitmap matches;
+        try {
+            matches = index.query(query);
+        } catch (const std::invalid_argument& error) {
+            consoleLines.push_back(std::string("Error: ") + error.what());
+            return;
+        }
+
+        std::size_t count = matches.cardinality();
+        consoleLines.push_back(std::to_string(count) + (count == 1 ? " item matches." : " items match."));
+        std::size_t listed = 0;
+        matches.forEachWhile([&](std::uint32_t item) {
+            consoleLines.push_back("- " + std::string(items.name(item)));
+            return ++listed < MAX_LISTED;
+        });
+        if (count > MAX_LISTED) consoleLines.push_back("... and " + std::to_string(count - MAX_LISTED) + " more.");
+    }
+
+    // Returns the name of the command
+    std::string getName() const override {
+        return "tags";
+    }
+};
+
 // --- TestYFastTrie ---
 
 
@@ -7,34 +7,246 @@
 
 #include <iostream>
 #include <SFML/Graphics.hpp>
-#include <functional>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Aggregate policies for AVL: a monoid over (key, value) pairs that every node maintains for its
+// subtree. `identity()` is the neutral element, `of()` lifts one entry and `combine()` must be
+// associative (in-order: left subtree, node, right subtree). `countsSize` says whether nodes also keep
+// their subtree size, which select() and rank() need.
+// Whatever a policy maintains has to be refreshed on every ancestor of a change, so only a policy with
+// an empty `type` and no sizes lets insert/remove stop rebalancing as soon as a subtree settles.
+
+// Default policy: maintains nothing and takes no space in the node
+template <typename Key, typename Value>
+struct NoAggregate {
+    struct type {};
+    static constexpr bool countsSize = false;
+    static type identity() { return {}; }
+    static type of(const Key&, const Value&) { return {}; }
+    static type combine(const type&, const type&) { return {}; }
+};
 
+// Sum of values, e.g. total price of the items in a key range
 template <typename Key, typename Value>
+struct SumAggregate {
+    using type = Value;
+    static constexpr bool countsSize = false;
+    static type identity() { return Value(); }
+    static type of(const Key&, const Value& value) { return value; }
+    static type combine(const type& a, const type& b) { return a + b; }
+};
+
+// Any policy plus subtree sizes, e.g. Counted<NoAggregate<K, V>> for select/rank alone
+template <typename Aggregate>
+struct Counted : Aggregate {
+    static constexpr bool countsSize = true;
+};
+
+// Bounded pool running the forked halves of AVL set operations, shared by every AVL type and started
+// on first use with one thread per extra core (the joining thread is the other worker), like
+// BatchPathfinder's pool. A forked task waits in a queue; whoever joins it runs it in place if no
+// worker has taken it yet and otherwise waits for that worker. Every wait is thus on a task some
+// thread is running, so nested forks cannot deadlock however few threads there are (even none).
+class AVLForkPool {
+public:
+    // A forked call; it refers to `function` without copying it and must be joined before either dies
+    class Task {
+    public:
+        template <typename Function>
+        explicit Task(Function& function)
+                : function(&function), invoke([](void* f) { (*static_cast<Function*>(f))(); }) {}
+
+    private:
+        friend class AVLForkPool;
+        enum class State { Queued, Running, Done };
+
+        void* function;
+        void (*invoke)(void*);
+        State state = State::Queued; // Guarded by the pool's mutex
+        std::exception_ptr failure;
+
+        void run() {
+            try {
+                invoke(function);
+            } catch (...) {
+                failure = std::current_exception();
+            }
+        }
+    };
+
+    static AVLForkPool& shared() {
+        static AVLForkPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    ~AVLForkPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) thread.join();
+    }
+
+    AVLForkPool(const AVLForkPool&) = delete;
+    AVLForkPool& operator=(const AVLForkPool&) = delete;
+
+    void fork(Task& task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(&task);
+        }
+        wake.notify_one();
+    }
+
+    // Wait for `task`, running it here if it is still queued, then rethrow whatever it threw
+    void join(Task& task) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (task.state == Task::State::Queued) {
+            queue.erase(std::find(queue.begin(), queue.end(), &task));
+            task.state = Task::State::Running;
+            lock.unlock();
+            task.run();
+        } else {
+            done.wait(lock, [&] { return task.state == Task::State::Done; });
+        }
+        if (task.failure) std::rethrow_exception(task.failure);
+    }
+
+    unsigned threadCount() const { return static_cast<unsigned>(threads.size()); }
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::deque<Task*> queue; // Oldest (largest) forks first
+    bool stopping = false;
+
+    // A thread that cannot be started only costs parallelism: joins run the work in place instead
+    explicit AVLForkPool(unsigned count) {
+        threads.reserve(count);
+        try {
+            for (unsigned i = 0; i < count; ++i) threads.emplace_back(&AVLForkPool::threadLoop, this);
+        } catch (const std::system_error&) {
+        }
+    }
+
+    void threadLoop() {
+        while (true) {
+            Task* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || !queue.empty(); });
+                if (stopping) return;
+                task = queue.front();
+                queue.pop_front();
+                task->state = Task::State::Running;
+            }
+
+            task->run();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                task->state = Task::State::Done;
+            }
+            done.notify_all();
+        }
+    }
+};
+
+template <typename Key, typename Value, typename Aggregate = NoAggregate<Key, Value>>
 class AVL {
 private:
+    using AggregateType = typename Aggregate::type;
+
+    static constexpr bool COUNTS_SIZE = Aggregate::countsSize;
+    static constexpr bool AGGREGATES = !std::is_empty_v<AggregateType>;
+
+    struct NoSize {};
+    using SizeType = std::conditional_t<COUNTS_SIZE, int, NoSize>;
+
     struct AVLNode {
         Key key;
         Value value;
         int height;
+        [[no_unique_address]] SizeType size; // Number of nodes in this subtree, if the policy counts them
+        [[no_unique_address]] AggregateType aggregate;
         AVLNode* left;
         AVLNode* right;
 
         AVLNode(Key k, Value v)
-                : key(k), value(v), height(1), left(nullptr), right(nullptr) {}
+                : key(k), value(v), height(1), size(), aggregate(Aggregate::of(key, value)), left(nullptr), right(nullptr) {
+            if constexpr (COUNTS_SIZE) size = 1;
+        }
     };
 
     AVLNode* root;
 
+    // AVL height never exceeds 1.44 log2(n + 2), so a fixed path stack of this depth covers any tree
+    static constexpr int MAX_HEIGHT = 96;
+
     // AVL helper functions
-    int height(AVLNode* node) {
+    static int height(AVLNode* node) {
         return node ? node->height : 0;
     }
 
-    int balanceFactor(AVLNode* node) {
+    static int balanceFactor(AVLNode* node) {
         return node ? height(node->left) - height(node->right) : 0;
     }
 
-    AVLNode* rotateRight(AVLNode* y) {
+    static int size(AVLNode* node) requires COUNTS_SIZE {
+        return node ? node->size : 0;
+    }
+
+    // Node count of a subtree by walking it, for policies that do not keep sizes
+    static int countNodes(const AVLNode* node) {
+        int count = 0;
+        const AVLNode* stack[MAX_HEIGHT];
+        int top = 0;
+        while (node || top > 0) {
+            for (; node; node = node->left) stack[top++] = node;
+            node = stack[--top];
+            ++count;
+            node = node->right;
+        }
+        return count;
+    }
+    // Complexity: O(n)
+
+    static AggregateType aggregateOf(AVLNode* node) {
+        return node ? node->aggregate : Aggregate::identity();
+    }
+
+    // Recompute height, plus size and aggregate when the policy keeps them, from the children
+    static void update(AVLNode* node) {
+        node->height = std::max(height(node->left), height(node->right)) + 1;
+        if constexpr (COUNTS_SIZE) {
+            node->size = size(node->left) + size(node->right) + 1;
+        }
+        if constexpr (AGGREGATES) {
+            node->aggregate = Aggregate::combine(Aggregate::combine(aggregateOf(node->left), Aggregate::of(node->key, node->value)),
+                                                 aggregateOf(node->right));
+        }
+    }
+
+    static AVLNode* rotateRight(AVLNode* y) {
         AVLNode* x = y->left;
         AVLNode* T2 = x->right;
 
@@ -42,15 +254,15 @@ private:
         x->right = y;
         y->left = T2;
 
-        // Update heights
-        y->height = std::max(height(y->left), height(y->right)) + 1;
-        x->height = std::max(height(x->left), height(x->right)) + 1;
+        // Update heights, sizes and aggregates
+        update(y);
+        update(x);
 
         // Return new root
         return x;
     }
 
-    AVLNode* rotateLeft(AVLNode* x) {
+    static AVLNode* rotateLeft(AVLNode* x) {
         AVLNode* y = x->right;
         AVLNode* T2 = y->left;
 
@@ -58,19 +270,19 @@ private:
         y->left = x;
         x->right = T2;
 
-        // Update heights
-        x->height = std::max(height(x->left), height(x->right)) + 1;
-        y->height = std::max(height(y->left), height(y->right)) + 1;
+        // Update heights, sizes and aggregates
+        update(x);
+        update(y);
 
         // Return new root
         return y;
     }
 
-    AVLNode* balance(AVLNode* node) {
+    static AVLNode* balance(AVLNode* node) {
         if (!node) return node;
 
-        // Update height
-        node->height = std::max(height(node->left), height(node->right)) + 1;
+        // Update height, size and aggregate
+        update(node);
 
         // Check balance factor
         int bf = balanceFactor(node);
@@ -94,60 +306,414 @@ private:
         return node;
     }
 
-    AVLNode* insert(AVLNode* node, Key key, Value value) {
-        if (!node) return new AVLNode(key, value);
+    // Perfectly balanced subtree over entries[0 .. count), built bottom-up
+    static AVLNode* buildBalanced(const std::pair<Key, Value>* entries, std::size_t count) {
+        if (count == 0) return nullptr;
 
-        if (key < node->key) {
-            node->left = insert(node->left, key, value);
-        } else if (key > node->key) {
-            node->right = insert(node->right, key, value);
-        } else {
-            node->value = value;  // Update value if key already exists
-            return node;
+        std::size_t mid = count / 2;
+        AVLNode* node = new AVLNode(entries[mid].first, entries[mid].second);
+        node->left = buildBalanced(entries, mid);
+        node->right = buildBalanced(entries + mid + 1, count - mid - 1);
+        update(node);
+        return node;
+    }
+    // Complexity: O(n)
+
+    static AVLNode* clone(const AVLNode* node) {
+        if (!node) return nullptr;
+
+        AVLNode* copy = new AVLNode(*node);
+        copy->left = clone(node->left);
+        copy->right = clone(node->right);
+        return copy;
+    }
+    // Complexity: O(n)
+
+    // join3 helpers: hang `mid` with (left, right) children on the spine of the taller tree where the
+    // heights first differ by at most one, then rebalance back up the spine
+    static AVLNode* joinRight(AVLNode* left, AVLNode* mid, AVLNode* right) {
+        if (height(left) <= height(right) + 1) {
+            mid->left = left;
+            mid->right = right;
+            update(mid);
+            return mid;
         }
+        left->right = joinRight(left->right, mid, right);
+        return balance(left);
+    }
 
-        return balance(node);
+    static AVLNode* joinLeft(AVLNode* left, AVLNode* mid, AVLNode* right) {
+        if (height(right) <= height(left) + 1) {
+            mid->left = left;
+            mid->right = right;
+            update(mid);
+            return mid;
+        }
+        right->left = joinLeft(left, mid, right->left);
+        return balance(right);
     }
-    // Complexity: O(log n)
 
-    // Complexity: O(log n)
+    // Tree holding every key of `left`, then `mid`, then every key of `right` (all keys of `left` are
+    // smaller than mid->key, all keys of `right` larger)
+    static AVLNode* join3(AVLNode* left, AVLNode* mid, AVLNode* right) {
+        if (height(left) > height(right) + 1) return joinRight(left, mid, right);
+        if (height(right) > height(left) + 1) return joinLeft(left, mid, right);
+
+        mid->left = left;
+        mid->right = right;
+        update(mid);
+        return mid;
+    }
+    // Complexity: O(|height(left) - height(right)| + 1)
 
-    AVLNode* removeMin(AVLNode* node) {
-        if (!node->left) return node->right;
-        node->left = removeMin(node->left);
+    // Detach the maximum node of a non-empty subtree
+    static AVLNode* detachMax(AVLNode* node, AVLNode*& max) {
+        if (!node->right) {
+            max = node;
+            return node->left;
+        }
+        node->right = detachMax(node->right, max);
         return balance(node);
     }
+
+    // join3 without a middle entry
+    static AVLNode* join2(AVLNode* left, AVLNode* right) {
+        if (!left) return right;
+        if (!right) return left;
+
+        AVLNode* max = nullptr;
+        left = detachMax(left, max);
+        return join3(left, max, right);
+    }
     // Complexity: O(log n)
 
-    AVLNode* remove(AVLNode* node, Key key) {
-        if (!node) return nullptr; // Base case: Key not found
+    // Partition a subtree into keys < key (left) and keys > key (right); the node holding `key`, if any,
+    // is returned detached in `match`
+    static void splitNode(AVLNode* node, const Key& key, AVLNode*& left, AVLNode*& match, AVLNode*& right) {
+        if (!node) {
+            left = match = right = nullptr;
+            return;
+        }
 
+        AVLNode* nodeLeft = node->left;
+        AVLNode* nodeRight = node->right;
         if (key < node->key) {
-            node->left = remove(node->left, key);
+            splitNode(nodeLeft, key, left, match, right);
+            right = join3(right, node, nodeRight);
         } else if (key > node->key) {
-            node->right = remove(node->right, key);
+            splitNode(nodeRight, key, left, match, right);
+            left = join3(nodeLeft, node, left);
+        } else {
+            match = node;
+            match->left = match->right = nullptr;
+            update(match);
+            left = nodeLeft;
+            right = nodeRight;
+        }
+    }
+    // Complexity: O(log n), the joins along the path telescope
+
+    // Free every node of a subtree without recursion: rotate left children up until there are none,
+    // then delete the node and continue with its right subtree.
+    static void destroy(AVLNode* node) {
+        while (node) {
+            if (node->left) {
+                AVLNode* left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } else {
+                AVLNode* right = node->right;
+                delete node;
+                node = right;
+            }
+        }
+    }
+    // Complexity: O(n) time, O(1) extra space
+
+    // Owns a detached subtree until released, so pieces split off for a set operation are freed if
+    // forking or the other half throws
+    struct SubtreeDeleter {
+        void operator()(AVLNode* node) const { destroy(node); }
+    };
+    using OwnedSubtree = std::unique_ptr<AVLNode, SubtreeDeleter>;
+
+    // Set operations split `b` around the root of `a` and recurse on both sides. The two recursive
+    // calls are independent, so while `depth` > 0 and either input is at least PARALLEL_GRAIN_HEIGHT
+    // tall (about 4096 nodes when balanced) the left one is forked onto AVLForkPool. Heights rather
+    // than sizes measure the work, so this does not need a size-counting policy. Both inputs are
+    // consumed, also when an exception escapes; nodes that do not survive are freed.
+    static constexpr int PARALLEL_GRAIN_HEIGHT = 12;
+
+    // op(aLeft, bLeft) and op(aRight, bRight), the first one possibly forked. Each input stays in a
+    // guard until its call takes it, and a finished half stays in one until both halves are done.
+    template <typename Operation>
+    static std::pair<AVLNode*, AVLNode*> forkJoin(int work, int depth, Operation operation,
+                                                  AVLNode* aLeft, AVLNode* bLeft, AVLNode* aRight, AVLNode* bRight) {
+        OwnedSubtree leftA(aLeft), leftB(bLeft), rightA(aRight), rightB(bRight);
+        OwnedSubtree leftResult, rightResult;
+        auto runLeft = [&] { leftResult.reset(operation(leftA.release(), leftB.release(), depth - 1)); };
+        auto runRight = [&] { rightResult.reset(operation(rightA.release(), rightB.release(), depth - 1)); };
+
+        if (depth > 0 && work >= PARALLEL_GRAIN_HEIGHT) {
+            AVLForkPool& pool = AVLForkPool::shared();
+            AVLForkPool::Task task(runLeft);
+            pool.fork(task);
+            try {
+                runRight();
+            } catch (...) {
+                // The task refers to this frame, so it has to finish first; the right half's error wins
+                try {
+                    pool.join(task);
+                } catch (...) {
+                }
+                throw;
+            }
+            pool.join(task);
         } else {
-            // Node to be deleted found
-            AVLNode* left = node->left;
-            AVLNode* right = node->right;
-            delete node; // Free memory
+            runLeft();
+            runRight();
+        }
+        return {leftResult.release(), rightResult.release()};
+    }
 
-            // Case 1: No right child, return left subtree
-            if (!right) return left;
+    // Every key of either tree; on equal keys the entry of `a` is kept
+    static AVLNode* unionNodes(AVLNode* a, AVLNode* b, int depth) {
+        if (!a) return b;
+        if (!b) return a;
+
+        AVLNode *bLeft, *match, *bRight;
+        int work = std::max(height(a), height(b));
+        splitNode(b, a->key, bLeft, match, bRight);
+        delete match;
+
+        AVLNode* aLeft = std::exchange(a->left, nullptr);
+        AVLNode* aRight = std::exchange(a->right, nullptr);
+        OwnedSubtree mid(a);
+        auto [left, right] = forkJoin(work, depth, unionNodes, aLeft, bLeft, aRight, bRight);
+        return join3(left, mid.release(), right);
+    }
+    // Complexity: O(m log(n / m + 1)) work, O(log^2 n) span
+
+    // Keys present in both trees, with the entries of `a`
+    static AVLNode* intersectionNodes(AVLNode* a, AVLNode* b, int depth) {
+        if (!a || !b) {
+            destroy(a);
+            destroy(b);
+            return nullptr;
+        }
+
+        AVLNode *bLeft, *match, *bRight;
+        int work = std::max(height(a), height(b));
+        splitNode(b, a->key, bLeft, match, bRight);
+        bool found = match != nullptr;
+        delete match;
+
+        AVLNode* aLeft = std::exchange(a->left, nullptr);
+        AVLNode* aRight = std::exchange(a->right, nullptr);
+        OwnedSubtree mid(a);
+        auto [left, right] = forkJoin(work, depth, intersectionNodes, aLeft, bLeft, aRight, bRight);
+        if (found) return join3(left, mid.release(), right);
+        return join2(left, right);
+    }
+    // Complexity: O(m log(n / m + 1)) work, O(log^2 n) span
+
+    // Keys of `a` that are not in `b`
+    static AVLNode* differenceNodes(AVLNode* a, AVLNode* b, int depth) {
+        if (!a || !b) {
+            destroy(b);
+            return a;
+        }
+
+        AVLNode *bLeft, *match, *bRight;
+        int work = std::max(height(a), height(b));
+        splitNode(b, a->key, bLeft, match, bRight);
+        bool found = match != nullptr;
+        delete match;
+
+        AVLNode* aLeft = std::exchange(a->left, nullptr);
+        AVLNode* aRight = std::exchange(a->right, nullptr);
+        OwnedSubtree mid(a);
+        auto [left, right] = forkJoin(work, depth, differenceNodes, aLeft, bLeft, aRight, bRight);
+        if (found) return join2(left, right);
+        return join3(left, mid.release(), right);
+    }
+    // Complexity: O(m log(n / m + 1)) work, O(log^2 n) span
+
+    explicit AVL(AVLNode* root) : root(root) {}
+
+    // Rebalance the subtrees referenced by path[top] .. path[0] (deepest first) after a change below them.
+    // With sizes or aggregates every ancestor is visited, because those change all the way up; otherwise
+    // it stops as soon as a subtree keeps its root and height, since nothing above it can change.
+    void rebalancePath(AVLNode** path[], int top) {
+        for (int i = top; i >= 0; --i) {
+            AVLNode* node = *path[i];
+            int oldHeight = node->height;
+            AVLNode* balanced = balance(node);
+            *path[i] = balanced;
+            if constexpr (!COUNTS_SIZE && !AGGREGATES) {
+                if (balanced == node && balanced->height == oldHeight) break;
+            }
+        }
+    }
+    // Complexity: O(log n)
+
+    // Rendering constants and cached geometry for visualizeAVL
+    static constexpr int NODE_RADIUS = 15;
+    static constexpr int NODE_SPACING = 35; // Horizontal distance between consecutive keys
+    static constexpr int LEVEL_SPACING = 50;
+    static constexpr unsigned LABEL_SIZE = 14;
+    static constexpr int CIRCLE_SEGMENTS = 16;
+    static constexpr std::size_t CIRCLE_VERTICES = CIRCLE_SEGMENTS * 3;
+
+    struct VisualLayout {
+        std::uint64_t mutations = 0;
+        const sf::Font* font = nullptr;
+        int originX = 0;
+        int originY = 0;
+        std::vector<float> nodeX;              // Top-left corner of each node, in-order (ascending)
+        std::vector<float> nodeY;
+        std::vector<sf::Vertex> circles;       // CIRCLE_VERTICES triangles per node, in-order
+        std::vector<int> parentRank;           // Edge to each node's parent, in-order; -1 for the root
+        std::vector<int> crossing;             // Scratch: edges reaching into the view from culled nodes
+        sf::VertexArray labels{sf::Triangles}; // Glyph quads textured from the font, in-order
+        std::vector<std::size_t> labelOffset;  // First label vertex of each node, plus an end sentinel
+        sf::VertexArray frame{sf::Triangles};  // Scratch buffer for the visible shapes of one frame
+    };
+
+    std::uint64_t mutations = 0; // Bumped whenever the tree's shape changes
+    mutable std::unique_ptr<VisualLayout> layout;
+
+    // Edge as a 1.5px wide quad, so it can share the circles' triangle batch
+    static void appendSegment(sf::VertexArray& vertices, sf::Vector2f from, sf::Vector2f to) {
+        sf::Vector2f direction(to.x - from.x, to.y - from.y);
+        float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+        if (length == 0) return;
+        sf::Vector2f normal(-direction.y / length * 0.75f, direction.x / length * 0.75f);
+
+        sf::Vertex corners[4] = {
+                sf::Vertex(sf::Vector2f(from.x + normal.x, from.y + normal.y), sf::Color::White),
+                sf::Vertex(sf::Vector2f(from.x - normal.x, from.y - normal.y), sf::Color::White),
+                sf::Vertex(sf::Vector2f(to.x - normal.x, to.y - normal.y), sf::Color::White),
+                sf::Vertex(sf::Vector2f(to.x + normal.x, to.y + normal.y), sf::Color::White)
+        };
+        for (int corner : {0, 1, 2, 0, 2, 3}) vertices.append(corners[corner]);
+    }
 
-            // Case 2: Find the minimum in the right subtree
-            AVLNode* min = findMin(right);
+    void buildLayout(int x, int y, const sf::Font& font) const {
+        if (!layout) layout = std::make_unique<VisualLayout>();
+        VisualLayout& cache = *layout;
+        cache.mutations = mutations;
+        cache.font = &font;
+        cache.originX = x;
+        cache.originY = y;
+
+        // Iterative in-order walk, so ranks come out in order without subtree sizes. A left child is
+        // visited before its parent and hands its rank down the stack; a right child already knows its
+        // parent's rank.
+        static constexpr int LEFT_CHILD = -1;
+        static constexpr int NO_PARENT = -2;
+        struct Frame { const AVLNode* node; int depth; int parentRank; int leftRank; };
+        std::vector<Frame> stack;
+        auto pushLeftSpine = [&](const AVLNode* node, int depth, int parentRank) {
+            for (; node; node = node->left) {
+                stack.push_back({node, depth++, parentRank, -1});
+                parentRank = LEFT_CHILD;
+            }
+        };
 
-            // Reassign pointers
-            min->right = removeMin(right); // Remove the minimum node
-            min->left = left;
+        std::vector<const AVLNode*> order;
+        std::vector<int> depths;
+        cache.parentRank.clear();
+        int rootRank = 0;
+        pushLeftSpine(root, 0, NO_PARENT);
+        while (!stack.empty()) {
+            Frame frame = stack.back();
+            stack.pop_back();
+
+            int rank = static_cast<int>(order.size());
+            order.push_back(frame.node);
+            depths.push_back(frame.depth);
+            cache.parentRank.push_back(frame.parentRank >= 0 ? frame.parentRank : -1);
+            if (frame.leftRank >= 0) cache.parentRank[frame.leftRank] = rank;
+            if (frame.parentRank == LEFT_CHILD) {
+                stack.back().leftRank = rank;
+            } else if (frame.parentRank == NO_PARENT) {
+                rootRank = rank;
+            }
+            pushLeftSpine(frame.node->right, frame.depth + 1, rank);
+        }
 
-            // Return balanced subtree
-            return balance(min);
+        int n = static_cast<int>(order.size());
+        float shift = static_cast<float>(x - rootRank * NODE_SPACING);
+        cache.nodeX.resize(n);
+        cache.nodeY.resize(n);
+        cache.circles.resize(static_cast<std::size_t>(n) * CIRCLE_VERTICES);
+        for (int rank = 0; rank < n; ++rank) {
+            float posX = shift + static_cast<float>(rank * NODE_SPACING);
+            float posY = static_cast<float>(y + depths[rank] * LEVEL_SPACING);
+            cache.nodeX[rank] = posX;
+            cache.nodeY[rank] = posY;
+
+            sf::Vector2f centre(posX + NODE_RADIUS, posY + NODE_RADIUS);
+            sf::Vertex* fan = &cache.circles[static_cast<std::size_t>(rank) * CIRCLE_VERTICES];
+            for (int segment = 0; segment < CIRCLE_SEGMENTS; ++segment) {
+                float a0 = 6.2831853f * static_cast<float>(segment) / CIRCLE_SEGMENTS;
+                float a1 = 6.2831853f * static_cast<float>(segment + 1) / CIRCLE_SEGMENTS;
+                fan[segment * 3] = sf::Vertex(centre, sf::Color::Green);
+                fan[segment * 3 + 1] = sf::Vertex(sf::Vector2f(centre.x + NODE_RADIUS * std::cos(a0), centre.y + NODE_RADIUS * std::sin(a0)), sf::Color::Green);
+                fan[segment * 3 + 2] = sf::Vertex(sf::Vector2f(centre.x + NODE_RADIUS * std::cos(a1), centre.y + NODE_RADIUS * std::sin(a1)), sf::Color::Green);
+            }
         }
 
-        return balance(node); // Balance the current node
+        // Labels: one textured quad per glyph, laid out like sf::Text with the baseline below the top edge
+        cache.labels.clear();
+        cache.labelOffset.assign(static_cast<std::size_t>(n) + 1, 0);
+        for (int rank = 0; rank < n; ++rank) {
+            cache.labelOffset[rank] = cache.labels.getVertexCount();
+            float penX = cache.nodeX[rank] + 5;
+            float baseline = cache.nodeY[rank] + 5 + LABEL_SIZE;
+
+            for (char c : std::to_string(order[rank]->key)) {
+                const sf::Glyph& glyph = font.getGlyph(static_cast<sf::Uint32>(static_cast<unsigned char>(c)), LABEL_SIZE, false);
+                float left = penX + glyph.bounds.left;
+                float top = baseline + glyph.bounds.top;
+                float right = left + glyph.bounds.width;
+                float bottom = top + glyph.bounds.height;
+                float u0 = static_cast<float>(glyph.textureRect.left);
+                float v0 = static_cast<float>(glyph.textureRect.top);
+                float u1 = u0 + static_cast<float>(glyph.textureRect.width);
+                float v1 = v0 + static_cast<float>(glyph.textureRect.height);
+
+                sf::Vertex corners[4] = {
+                        sf::Vertex(sf::Vector2f(left, top), sf::Color::Black, sf::Vector2f(u0, v0)),
+                        sf::Vertex(sf::Vector2f(right, top), sf::Color::Black, sf::Vector2f(u1, v0)),
+                        sf::Vertex(sf::Vector2f(right, bottom), sf::Color::Black, sf::Vector2f(u1, v1)),
+                        sf::Vertex(sf::Vector2f(left, bottom), sf::Color::Black, sf::Vector2f(u0, v1))
+                };
+                for (int corner : {0, 1, 2, 0, 2, 3}) cache.labels.append(corners[corner]);
+                penX += glyph.advance;
+            }
+        }
+        cache.labelOffset[n] = cache.labels.getVertexCount();
+    }
+    // Complexity: O(n)
+
+    // Height of a subtree recomputed from scratch, or -1 if a stored height (or size, when counted) is
+    // stale or a node is unbalanced
+    static int checkedHeight(AVLNode* node) {
+        if (!node) return 0;
+
+        int left = checkedHeight(node->left);
+        int right = checkedHeight(node->right);
+        if (left < 0 || right < 0 || left - right > 1 || right - left > 1) return -1;
+        if (node->height != std::max(left, right) + 1) return -1;
+        if constexpr (COUNTS_SIZE) {
+            if (node->size != size(node->left) + size(node->right) + 1) return -1;
+        }
+        return node->height;
     }
+    // Complexity: O(n)
 
     void displayHelper(AVLNode* node, int depth) const {
         if (!node) return;
@@ -165,24 +731,169 @@ private:
 public:
     AVL() : root(nullptr) {}
     ~AVL() {
-        std::function<void(AVLNode*)> deleteNodes = [&](AVLNode* node) {
-            if (!node) return;
-            deleteNodes(node->left);
-            deleteNodes(node->right);
-            delete node;
-        };
-        deleteNodes(root);
+        clear();
+    }
+
+    AVL(const AVL& other) : root(clone(other.root)) {}
+
+    AVL(AVL&& other) noexcept : root(std::exchange(other.root, nullptr)) {}
+
+    AVL& operator=(AVL other) noexcept {
+        std::swap(root, other.root);
+        ++mutations;
+        return *this;
+    }
+
+    // Build a perfectly balanced tree from entries sorted by strictly increasing key
+    static AVL fromSorted(std::span<const std::pair<Key, Value>> entries) {
+        for (std::size_t i = 1; i < entries.size(); ++i) {
+            if (!(entries[i - 1].first < entries[i].first)) {
+                throw std::invalid_argument("AVL::fromSorted requires strictly increasing keys");
+            }
+        }
+        return AVL(buildBalanced(entries.data(), entries.size()));
+    }
+    // Complexity: O(n), no rotations
+
+    // Move every key < `key` into the first tree and every key >= `key` into the second.
+    // This tree is left empty.
+    std::pair<AVL, AVL> split(Key key) {
+        AVLNode* left = nullptr;
+        AVLNode* match = nullptr;
+        AVLNode* right = nullptr;
+        splitNode(std::exchange(root, nullptr), key, left, match, right);
+        if (match) right = join3(nullptr, match, right);
+        return {AVL(left), AVL(right)};
+    }
+    // Complexity: O(log n)
+
+    // Concatenate two trees where every key of `left` is smaller than every key of `right`.
+    // Both arguments are left empty.
+    static AVL join(AVL&& left, AVL&& right) {
+        AVLNode* leftMax = left.findMax();
+        AVLNode* rightMin = right.findMin();
+        if (leftMax && rightMin && !(leftMax->key < rightMin->key)) {
+            throw std::invalid_argument("AVL::join requires every left key to be smaller than every right key");
+        }
+        return AVL(join2(std::exchange(left.root, nullptr), std::exchange(right.root, nullptr)));
+    }
+    // Complexity: O(log n)
+
+    // Fork depth used by the set operations: floor(log2(cores)) levels, so there are at most as many
+    // concurrent halves as cores, and 0 (sequential) on a single core where forking only adds overhead
+    static int defaultParallelDepth() {
+        unsigned cores = std::thread::hardware_concurrency();
+        if (cores <= 1) return 0;
+        return std::bit_width(cores) - 1;
     }
 
+    // Set operations over two trees; both arguments are consumed. Pass parallelDepth = 0 to run
+    // sequentially. On keys present in both trees the entry of `a` is kept.
+    static AVL setUnion(AVL&& a, AVL&& b, int parallelDepth = defaultParallelDepth()) {
+        return AVL(unionNodes(std::exchange(a.root, nullptr), std::exchange(b.root, nullptr), parallelDepth));
+    }
+    // Complexity: O(m log(n / m + 1)) for sizes m <= n
+
+    static AVL setIntersection(AVL&& a, AVL&& b, int parallelDepth = defaultParallelDepth()) {
+        return AVL(intersectionNodes(std::exchange(a.root, nullptr), std::exchange(b.root, nullptr), parallelDepth));
+    }
+    // Complexity: O(m log(n / m + 1)) for sizes m <= n
+
+    static AVL setDifference(AVL&& a, AVL&& b, int parallelDepth = defaultParallelDepth()) {
+        return AVL(differenceNodes(std::exchange(a.root, nullptr), std::exchange(b.root, nullptr), parallelDepth));
+    }
+    // Complexity: O(m log(n / m + 1)) for sizes m <= n
+
+    void clear() {
+        destroy(root);
+        root = nullptr;
+        ++mutations;
+    }
+    // Complexity: O(n) time, O(1) extra space
+
 
     // Public interface
     void insert(Key key, Value value) {
-        root = insert(root, key, value);
+        AVLNode** path[MAX_HEIGHT];
+        int depth = 0;
+        AVLNode** link = &root;
+
+        while (*link) {
+            AVLNode* node = *link;
+            if (key < node->key) {
+                path[depth++] = link;
+                link = &node->left;
+            } else if (key > node->key) {
+                path[depth++] = link;
+                link = &node->right;
+            } else {
+                node->value = value;  // Update value if key already exists
+                if constexpr (AGGREGATES) {
+                    update(node);
+                    rebalancePath(path, depth - 1);
+                }
+                return;
+            }
+        }
+
+        *link = new AVLNode(key, value);
+        rebalancePath(path, depth - 1);
+        ++mutations;
     }
     // Complexity: O(log n)
 
     void remove(Key key) {
-        root = remove(root, key);
+        AVLNode** path[MAX_HEIGHT];
+        int depth = 0;
+        AVLNode** link = &root;
+
+        while (*link) {
+            AVLNode* node = *link;
+            if (key < node->key) {
+                path[depth++] = link;
+                link = &node->left;
+            } else if (key > node->key) {
+                path[depth++] = link;
+                link = &node->right;
+            } else {
+                break;
+            }
+        }
+
+        AVLNode* node = *link;
+        if (!node) return; // Key not found
+
+        if (!node->right) {
+            // Case 1: No right child, splice in the left subtree
+            *link = node->left;
+        } else {
+            // Case 2: Replace the node with the minimum of its right subtree
+            int nodeDepth = depth;
+            path[depth++] = link;
+
+            AVLNode** minLink = &node->right;
+            while ((*minLink)->left) {
+                path[depth++] = minLink;
+                minLink = &(*minLink)->left;
+            }
+
+            AVLNode* min = *minLink;
+            *minLink = min->right; // Unlink the minimum node
+            min->left = node->left;
+            min->right = node->right;
+            *link = min;
+            // `min` inherits the removed node's height: it is exact if rebalancePath stops below this
+            // level, and otherwise the old value is what the walk compares against to decide whether
+            // the ancestors changed
+            min->height = node->height;
+
+            // The path went through node->right, which now lives in the replacement
+            if (depth > nodeDepth + 1) path[nodeDepth + 1] = &min->right;
+        }
+
+        delete node; // Free memory
+        rebalancePath(path, depth - 1);
+        ++mutations;
     }
     // Complexity: O(log n)
 
@@ -217,48 +928,144 @@ public:
     }
     // Complexity: O(log n)
     AVLNode* findMin(AVLNode* node) {
-        return node->left ? findMin(node->left) : node;
+        while (node && node->left) {
+            node = node->left;
+        }
+        return node;
     }
 
     AVLNode* findMin() {
-        return findMin(root); // Call the recursive helper
+        return findMin(root);
     }
 
     AVLNode* findMax() {
-        return findMax(root); // Add a recursive helper similar to `findMin`
+        return findMax(root);
     }
 
-// Example of `findMax` helper
     AVLNode* findMax(AVLNode* node) {
-        return node->right ? findMax(node->right) : node;
+        while (node && node->right) {
+            node = node->right;
+        }
+        return node;
     }
 
+    // Largest key strictly smaller than `key` within the subtree.
+    // The next child is picked by index instead of a branch, so random probes don't pay for
+    // mispredicted comparisons on every level.
     AVLNode* pred(AVLNode* node, Key key) {
-        if (!node) return nullptr;
-
-        if (key <= node->key) {
-            return pred(node->left, key);
-        } else {
-            AVLNode* temp = pred(node->right, key);
-            return temp ? temp : node;
+        AVLNode* candidate = nullptr;
+        while (node) {
+            AVLNode* children[2] = {node->left, node->right};
+            bool goRight = key > node->key;
+            if (goRight) candidate = node;
+            node = children[goRight];
         }
+        return candidate;
     }
+    // Complexity: O(log n)
 
+    // Smallest key strictly greater than `key` within the subtree
     AVLNode* succ(AVLNode* node, Key key) {
-        if (!node) return nullptr;
-
-        if (key >= node->key) {
-            return succ(node->right, key);
-        } else {
-            AVLNode* temp = succ(node->left, key);
-            return temp ? temp : node;
+        AVLNode* candidate = nullptr;
+        while (node) {
+            AVLNode* children[2] = {node->left, node->right};
+            bool goLeft = key < node->key;
+            if (goLeft) candidate = node;
+            node = children[!goLeft];
         }
+        return candidate;
     }
+    // Complexity: O(log n)
 
     bool isEmpty() const {
         return root == nullptr;
     }
 
+    // Check that every stored height (and size, when counted) is current and every node satisfies the
+    // AVL balance condition
+    bool isBalanced() const {
+        return checkedHeight(root) >= 0;
+    }
+    // Complexity: O(n)
+
+    // O(1) when the policy counts sizes, otherwise a walk over the tree
+    int size() const {
+        if constexpr (COUNTS_SIZE) {
+            return size(root);
+        } else {
+            return countNodes(root);
+        }
+    }
+
+    // k-th smallest node (0-based), or nullptr if k is out of range
+    AVLNode* select(int k) requires COUNTS_SIZE {
+        AVLNode* node = root;
+        while (node) {
+            int leftSize = size(node->left);
+            if (k < leftSize) {
+                node = node->left;
+            } else if (k == leftSize) {
+                return node;
+            } else {
+                k -= leftSize + 1;
+                node = node->right;
+            }
+        }
+        return nullptr;
+    }
+    // Complexity: O(log n)
+
+    // Number of keys strictly smaller than `key`
+    int rank(Key key) requires COUNTS_SIZE {
+        int smaller = 0;
+        AVLNode* node = root;
+        while (node) {
+            if (key <= node->key) {
+                node = node->left;
+            } else {
+                smaller += size(node->left) + 1;
+                node = node->right;
+            }
+        }
+        return smaller;
+    }
+    // Complexity: O(log n)
+
+    // Aggregate of every entry with lo <= key <= hi, combined in key order
+    AggregateType aggregate(Key lo, Key hi) {
+        // Descend to the first node inside the range; the whole range lies in its subtree
+        AVLNode* split = root;
+        while (split && (split->key < lo || split->key > hi)) {
+            split = split->key < lo ? split->right : split->left;
+        }
+        if (!split) return Aggregate::identity();
+
+        // Keys >= lo in the left subtree, collected right to left
+        AggregateType leftPart = Aggregate::identity();
+        for (AVLNode* node = split->left; node;) {
+            if (node->key >= lo) {
+                leftPart = Aggregate::combine(Aggregate::combine(Aggregate::of(node->key, node->value), aggregateOf(node->right)), leftPart);
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+
+        // Keys <= hi in the right subtree, collected left to right
+        AggregateType rightPart = Aggregate::identity();
+        for (AVLNode* node = split->right; node;) {
+            if (node->key <= hi) {
+                rightPart = Aggregate::combine(rightPart, Aggregate::combine(aggregateOf(node->left), Aggregate::of(node->key, node->value)));
+                node = node->right;
+            } else {
+                node = node->left;
+            }
+        }
+
+        return Aggregate::combine(Aggregate::combine(leftPart, Aggregate::of(split->key, split->value)), rightPart);
+    }
+    // Complexity: O(log n)
+
     void display() const {
         if (!root) {
             std::cout << "AVL Tree is empty.\n";
@@ -277,54 +1084,75 @@ public:
         return succ(root, key);
     }
 
-    void visualizeAVL(sf::RenderWindow &window, int x, int y, sf::Font consoleFont) const {
+    // Draw the tree with its root's top-left corner at (x, y). Nodes sit at their in-order rank
+    // horizontally and their depth vertically, so subtrees never overlap. The layout and all vertices
+    // are cached until the tree's shape changes; each frame submits one draw call for the visible
+    // edges and circles and one for the visible labels.
+    void visualizeAVL(sf::RenderWindow &window, int x, int y, const sf::Font &consoleFont) const {
         if (!root) return;
 
-        const int NODE_RADIUS = 15;
-        const int OFFSET_X = 50;
-        const int OFFSET_Y = 50;
-
-        std::function<void(AVLNode *, int, int)> drawNode = [&](AVLNode *node, int posX, int posY) {
-            if (!node) return;
-
-            // Draw current node
-            sf::CircleShape nodeShape(NODE_RADIUS);
-            nodeShape.setFillColor(sf::Color::Green);
-            nodeShape.setPosition(posX, posY);
-
-            sf::Text nodeLabel;
-            nodeLabel.setFont(consoleFont);
-            nodeLabel.setCharacterSize(14);
-            nodeLabel.setFillColor(sf::Color::Black);
-            nodeLabel.setString(std::to_string(node->key));
-            nodeLabel.setPosition(posX + 5, posY + 5);
-
-            window.draw(nodeShape);
-            window.draw(nodeLabel);
-
-            // Draw left child
-            if (node->left) {
-                sf::Vertex line[] = {
-                        sf::Vertex(sf::Vector2f(posX + NODE_RADIUS, posY + NODE_RADIUS)),
-                        sf::Vertex(sf::Vector2f(posX - OFFSET_X + NODE_RADIUS, posY + OFFSET_Y + NODE_RADIUS))
-                };
-                window.draw(line, 2, sf::Lines);
-                drawNode(node->left, posX - OFFSET_X, posY + OFFSET_Y);
-            }
-
-            // Draw right child
-            if (node->right) {
-                sf::Vertex line[] = {
-                        sf::Vertex(sf::Vector2f(posX + NODE_RADIUS, posY + NODE_RADIUS)),
-                        sf::Vertex(sf::Vector2f(posX + OFFSET_X + NODE_RADIUS, posY + OFFSET_Y + NODE_RADIUS))
-                };
-                window.draw(line, 2, sf::Lines);
-                drawNode(node->right, posX + OFFSET_X, posY + OFFSET_Y);
+        if (!layout || layout->mutations != mutations || layout->font != &consoleFont
+            || layout->originX != x || layout->originY != y) {
+            buildLayout(x, y, consoleFont);
+        }
+        VisualLayout& cache = *layout;
+
+        // Visible area of the window's current view
+        const sf::View& view = window.getView();
+        float left = view.getCenter().x - view.getSize().x / 2;
+        float top = view.getCenter().y - view.getSize().y / 2;
+        float right = left + view.getSize().x;
+        float bottom = top + view.getSize().y;
+
+        // Nodes are stored in in-order, so the horizontally visible ones form one contiguous range
+        auto first = static_cast<std::size_t>(std::lower_bound(cache.nodeX.begin(), cache.nodeX.end(), left - 2 * NODE_RADIUS) - cache.nodeX.begin());
+        auto last = static_cast<std::size_t>(std::upper_bound(cache.nodeX.begin(), cache.nodeX.end(), right) - cache.nodeX.begin());
+
+        // Edges of visible nodes, plus the ones that only pass through the view. Those cross one of
+        // the range's borders, and every edge crossing the gap between two in-order neighbours lies on
+        // one of their paths to the root, so walking up from the four border nodes (one edge per
+        // level) finds them all without touching culled nodes.
+        auto n = static_cast<int>(cache.nodeX.size());
+        int firstRank = static_cast<int>(first);
+        int lastRank = static_cast<int>(last);
+        cache.crossing.clear();
+        for (int border : {firstRank - 1, firstRank, lastRank - 1, lastRank}) {
+            for (int rank = border; rank >= 0 && rank < n; rank = cache.parentRank[rank]) {
+                if (rank < firstRank || rank >= lastRank) cache.crossing.push_back(rank);
             }
+        }
+        std::sort(cache.crossing.begin(), cache.crossing.end());
+        cache.crossing.erase(std::unique(cache.crossing.begin(), cache.crossing.end()), cache.crossing.end());
+
+        cache.frame.clear();
+        auto appendEdge = [&](int child) {
+            int parent = cache.parentRank[child];
+            if (parent < 0) return;
+            sf::Vector2f from(cache.nodeX[parent] + NODE_RADIUS, cache.nodeY[parent] + NODE_RADIUS);
+            sf::Vector2f to(cache.nodeX[child] + NODE_RADIUS, cache.nodeY[child] + NODE_RADIUS);
+            if (std::max(from.x, to.x) < left || std::min(from.x, to.x) > right || to.y < top || from.y > bottom) return;
+            appendSegment(cache.frame, from, to);
         };
+        for (int rank : cache.crossing) appendEdge(rank);
+        for (int rank = firstRank; rank < lastRank; ++rank) appendEdge(rank);
+        for (std::size_t i = first; i < last; ++i) {
+            if (cache.nodeY[i] + 2 * NODE_RADIUS < top || cache.nodeY[i] > bottom) continue;
+            for (std::size_t v = i * CIRCLE_VERTICES; v < (i + 1) * CIRCLE_VERTICES; ++v) {
+                cache.frame.append(cache.circles[v]);
+            }
+        }
+        if (cache.frame.getVertexCount() > 0) {
+            window.draw(cache.frame);
+        }
 
-        drawNode(root, x, y);
+        std::size_t labelBegin = cache.labelOffset[first];
+        std::size_t labelEnd = cache.labelOffset[last];
+        if (labelEnd > labelBegin) {
+            sf::RenderStates states(&consoleFont.getTexture(LABEL_SIZE));
+            window.draw(&cache.labels[labelBegin], labelEnd - labelBegin, sf::Triangles, states);
+        }
     }
+    // Complexity: O(n) to rebuild after a mutation, then O(log n + visible nodes) per frame
 
 };
 
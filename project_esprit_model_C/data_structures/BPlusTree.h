@@ -0,0 +1,386 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_BPLUSTREE_H
+#define PROJECT_ESPRIT_MODEL_C_BPLUSTREE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Ordered map backed by a B+-tree whose key arrays are sized and aligned to 64-byte cache lines.
+// Inner nodes only route; all entries live in leaves, which form a doubly linked list so successor
+// and predecessor queries step to a neighbouring leaf instead of re-descending.
+// Node search counts keys with a branchless loop over the contiguous key array, which compilers
+// turn into SIMD compares for integral keys.
+// Shares the query API of YFastTrie so both can be used as an OrderedIndex backend.
+template <typename Key, typename Value>
+class BPlusTree {
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+    static constexpr std::size_t KEY_LINES = 2; // Cache lines of keys per node
+    static constexpr std::size_t MAX_KEYS = std::max<std::size_t>(4, KEY_LINES * CACHE_LINE / sizeof(Key));
+    static constexpr std::size_t MIN_KEYS = MAX_KEYS / 2 - 1;
+
+    struct Node {
+        alignas(CACHE_LINE) Key keys[MAX_KEYS];
+        std::uint32_t count = 0;
+        bool leaf;
+
+        explicit Node(bool leaf) : leaf(leaf) {}
+    };
+
+    struct Inner : Node {
+        Node* children[MAX_KEYS + 1];
+
+        Inner() : Node(false) {}
+    };
+
+    struct Leaf : Node {
+        Value values[MAX_KEYS];
+        Leaf* prev = nullptr;
+        Leaf* next = nullptr;
+
+        Leaf() : Node(true) {}
+    };
+
+    Node* root;
+    std::size_t entries = 0;
+
+    // Number of keys in the node strictly smaller than `key`
+    static std::uint32_t countLess(const Node* node, const Key& key) {
+        std::uint32_t rank = 0;
+        for (std::uint32_t i = 0; i < node->count; ++i) {
+            rank += node->keys[i] < key;
+        }
+        return rank;
+    }
+
+    // Number of keys in the node smaller than or equal to `key`
+    static std::uint32_t countLessEqual(const Node* node, const Key& key) {
+        std::uint32_t rank = 0;
+        for (std::uint32_t i = 0; i < node->count; ++i) {
+            rank += !(key < node->keys[i]);
+        }
+        return rank;
+    }
+
+    static Inner* asInner(Node* node) { return static_cast<Inner*>(node); }
+    static Leaf* asLeaf(Node* node) { return static_cast<Leaf*>(node); }
+
+    // Leaf whose key range contains `key`
+    Leaf* findLeaf(const Key& key) const {
+        Node* node = root;
+        while (!node->leaf) {
+            node = asInner(node)->children[countLessEqual(node, key)];
+        }
+        return asLeaf(node);
+    }
+
+    // Split the full child `index` of `parent` into two halves
+    static void splitChild(Inner* parent, std::uint32_t index) {
+        Node* child = parent->children[index];
+        std::uint32_t half = static_cast<std::uint32_t>(MAX_KEYS / 2);
+        Key separator;
+        Node* right;
+
+        if (child->leaf) {
+            Leaf* left = asLeaf(child);
+            Leaf* sibling = new Leaf();
+            sibling->count = left->count - half;
+            std::move(left->keys + half, left->keys + left->count, sibling->keys);
+            std::move(left->values + half, left->values + left->count, sibling->values);
+            left->count = half;
+
+            sibling->next = left->next;
+            sibling->prev = left;
+            if (left->next) left->next->prev = sibling;
+            left->next = sibling;
+
+            separator = sibling->keys[0];
+            right = sibling;
+        } else {
+            Inner* left = asInner(child);
+            Inner* sibling = new Inner();
+            sibling->count = left->count - half - 1;
+            std::move(left->keys + half + 1, left->keys + left->count, sibling->keys);
+            std::move(left->children + half + 1, left->children + left->count + 1, sibling->children);
+            separator = left->keys[half];
+            left->count = half;
+            right = sibling;
+        }
+
+        std::move_backward(parent->keys + index, parent->keys + parent->count, parent->keys + parent->count + 1);
+        std::move_backward(parent->children + index + 1, parent->children + parent->count + 1, parent->children + parent->count + 2);
+        parent->keys[index] = separator;
+        parent->children[index + 1] = right;
+        ++parent->count;
+    }
+
+    // Make sure child `index` of `parent` holds more than MIN_KEYS keys before descending into it
+    static void growChild(Inner* parent, std::uint32_t index) {
+        Node* left = index > 0 ? parent->children[index - 1] : nullptr;
+        Node* right = index < parent->count ? parent->children[index + 1] : nullptr;
+
+        if (left && left->count > MIN_KEYS) {
+            borrowFromLeft(parent, index);
+        } else if (right && right->count > MIN_KEYS) {
+            borrowFromRight(parent, index);
+        } else if (right) {
+            merge(parent, index);
+        } else {
+            merge(parent, index - 1);
+        }
+    }
+
+    static void borrowFromLeft(Inner* parent, std::uint32_t index) {
+        Node* child = parent->children[index];
+        Node* left = parent->children[index - 1];
+        std::move_backward(child->keys, child->keys + child->count, child->keys + child->count + 1);
+
+        if (child->leaf) {
+            Leaf* to = asLeaf(child);
+            Leaf* from = asLeaf(left);
+            std::move_backward(to->values, to->values + to->count, to->values + to->count + 1);
+            to->keys[0] = std::move(from->keys[from->count - 1]);
+            to->values[0] = std::move(from->values[from->count - 1]);
+            parent->keys[index - 1] = to->keys[0];
+        } else {
+            Inner* to = asInner(child);
+            Inner* from = asInner(left);
+            std::move_backward(to->children, to->children + to->count + 1, to->children + to->count + 2);
+            to->keys[0] = std::move(parent->keys[index - 1]);
+            to->children[0] = from->children[from->count];
+            parent->keys[index - 1] = std::move(from->keys[from->count - 1]);
+        }
+
+        ++child->count;
+        --left->count;
+    }
+
+    static void borrowFromRight(Inner* parent, std::uint32_t index) {
+        Node* child = parent->children[index];
+        Node* right = parent->children[index + 1];
+
+        if (child->leaf) {
+            Leaf* to = asLeaf(child);
+            Leaf* from = asLeaf(right);
+            to->keys[to->count] = std::move(from->keys[0]);
+            to->values[to->count] = std::move(from->values[0]);
+            std::move(from->keys + 1, from->keys + from->count, from->keys);
+            std::move(from->values + 1, from->values + from->count, from->values);
+            parent->keys[index] = from->keys[0];
+        } else {
+            Inner* to = asInner(child);
+            Inner* from = asInner(right);
+            to->keys[to->count] = std::move(parent->keys[index]);
+            to->children[to->count + 1] = from->children[0];
+            parent->keys[index] = std::move(from->keys[0]);
+            std::move(from->keys + 1, from->keys + from->count, from->keys);
+            std::move(from->children + 1, from->children + from->count + 1, from->children);
+        }
+
+        ++child->count;
+        --right->count;
+    }
+
+    // Merge child `index + 1` of `parent` into child `index`
+    static void merge(Inner* parent, std::uint32_t index) {
+        Node* left = parent->children[index];
+        Node* right = parent->children[index + 1];
+
+        if (left->leaf) {
+            Leaf* to = asLeaf(left);
+            Leaf* from = asLeaf(right);
+            std::move(from->keys, from->keys + from->count, to->keys + to->count);
+            std::move(from->values, from->values + from->count, to->values + to->count);
+            to->count += from->count;
+            to->next = from->next;
+            if (from->next) from->next->prev = to;
+            delete from;
+        } else {
+            Inner* to = asInner(left);
+            Inner* from = asInner(right);
+            to->keys[to->count] = std::move(parent->keys[index]);
+            std::move(from->keys, from->keys + from->count, to->keys + to->count + 1);
+            std::move(from->children, from->children + from->count + 1, to->children + to->count + 1);
+            to->count += from->count + 1;
+            delete from;
+        }
+
+        std::move(parent->keys + index + 1, parent->keys + parent->count, parent->keys + index);
+        std::move(parent->children + index + 2, parent->children + parent->count + 1, parent->children + index + 1);
+        --parent->count;
+    }
+
+    static void destroy(Node* node) {
+        if (!node->leaf) {
+            Inner* inner = asInner(node);
+            for (std::uint32_t i = 0; i <= inner->count; ++i) {
+                destroy(inner->children[i]);
+            }
+            delete inner;
+        } else {
+            delete asLeaf(node);
+        }
+    }
+
+public:
+    // Query result: the found key and a pointer to its value inside the leaf, or empty
+    using Entry = std::optional<std::pair<Key, Value*>>;
+
+    BPlusTree() : root(new Leaf()) {}
+    ~BPlusTree() { destroy(root); }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    void insert(Key key, Value value) {
+        if (root->count == MAX_KEYS) {
+            Inner* newRoot = new Inner();
+            newRoot->children[0] = root;
+            root = newRoot;
+            splitChild(newRoot, 0);
+        }
+
+        // Split full nodes on the way down so the leaf always has room
+        Node* node = root;
+        while (!node->leaf) {
+            Inner* inner = asInner(node);
+            std::uint32_t index = countLessEqual(inner, key);
+            if (inner->children[index]->count == MAX_KEYS) {
+                splitChild(inner, index);
+                if (!(key < inner->keys[index])) ++index;
+            }
+            node = inner->children[index];
+        }
+
+        Leaf* leaf = asLeaf(node);
+        std::uint32_t pos = countLess(leaf, key);
+        if (pos < leaf->count && !(key < leaf->keys[pos])) {
+            leaf->values[pos] = std::move(value); // Update value if key already exists
+            return;
+        }
+
+        std::move_backward(leaf->keys + pos, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::move_backward(leaf->values + pos, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[pos] = key;
+        leaf->values[pos] = std::move(value);
+        ++leaf->count;
+        ++entries;
+    }
+    // Complexity: O(log_B n) node visits, B = MAX_KEYS
+
+    void remove(Key key) {
+        // Grow minimal nodes on the way down so the leaf can always lose a key
+        Node* node = root;
+        while (!node->leaf) {
+            Inner* inner = asInner(node);
+            std::uint32_t index = countLessEqual(inner, key);
+            if (inner->children[index]->count <= MIN_KEYS) {
+                growChild(inner, index);
+                index = countLessEqual(inner, key);
+            }
+            node = inner->children[index];
+
+            if (inner == root && inner->count == 0) {
+                root = inner->children[0]; // Root lost its last separator
+                delete inner;
+            }
+        }
+
+        Leaf* leaf = asLeaf(node);
+        std::uint32_t pos = countLess(leaf, key);
+        if (pos == leaf->count || key < leaf->keys[pos]) return; // Key not found
+
+        std::move(leaf->keys + pos + 1, leaf->keys + leaf->count, leaf->keys + pos);
+        std::move(leaf->values + pos + 1, leaf->values + leaf->count, leaf->values + pos);
+        --leaf->count;
+        --entries;
+    }
+    // Complexity: O(log_B n) node visits
+
+    Value* search(Key key) {
+        Leaf* leaf = findLeaf(key);
+        std::uint32_t pos = countLess(leaf, key);
+        if (pos == leaf->count || key < leaf->keys[pos]) return nullptr;
+        return &leaf->values[pos];
+    }
+    // Complexity: O(log_B n) node visits
+
+    // Largest key strictly smaller than `key`
+    Entry predecessor(Key key) {
+        Leaf* leaf = findLeaf(key);
+        std::uint32_t pos = countLess(leaf, key);
+        if (pos == 0) {
+            leaf = leaf->prev;
+            if (!leaf) return std::nullopt;
+            pos = leaf->count;
+        }
+        return std::pair<Key, Value*>(leaf->keys[pos - 1], &leaf->values[pos - 1]);
+    }
+
+    // Smallest key strictly greater than `key`
+    Entry successor(Key key) {
+        Leaf* leaf = findLeaf(key);
+        std::uint32_t pos = countLessEqual(leaf, key);
+        if (pos == leaf->count) {
+            leaf = leaf->next;
+            if (!leaf) return std::nullopt;
+            pos = 0;
+        }
+        return std::pair<Key, Value*>(leaf->keys[pos], &leaf->values[pos]);
+    }
+
+    // Batched predecessor queries, answered in probe order.
+    // Probes are visited in sorted order; a probe that still falls in the previous probe's leaf
+    // is answered there without descending from the root.
+    std::vector<Entry> predecessor_many(std::span<const Key> keys) {
+        std::vector<Entry> results(keys.size());
+        std::vector<std::size_t> order(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+
+        Leaf* leaf = nullptr;
+        for (std::size_t index : order) {
+            Key key = keys[index];
+            bool inLeaf = leaf && leaf->count && leaf->keys[0] < key
+                          && (!leaf->next || !(leaf->next->keys[0] < key));
+            if (!inLeaf) {
+                results[index] = predecessor(key);
+                leaf = findLeaf(key);
+                continue;
+            }
+
+            std::uint32_t pos = countLess(leaf, key);
+            results[index] = std::pair<Key, Value*>(leaf->keys[pos - 1], &leaf->values[pos - 1]);
+        }
+
+        return results;
+    }
+
+    std::size_t size() const { return entries; }
+    bool isEmpty() const { return entries == 0; }
+
+    void display() const {
+        std::cout << "B+ Tree Contents:\n";
+        Node* node = root;
+        while (!node->leaf) node = asInner(node)->children[0];
+
+        for (Leaf* leaf = asLeaf(node); leaf; leaf = leaf->next) {
+            std::cout << "Leaf:";
+            for (std::uint32_t i = 0; i < leaf->count; ++i) {
+                std::cout << " " << leaf->keys[i] << ": " << leaf->values[i] << ";";
+            }
+            std::cout << "\n";
+        }
+    }
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_BPLUSTREE_H
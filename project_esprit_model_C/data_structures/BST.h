@@ -1,52 +1,318 @@
 #ifndef PROJECT_ESPRIT_MODEL_C_BST_H
 #define PROJECT_ESPRIT_MODEL_C_BST_H
 
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
 template <typename T>
 struct BSTNode {
     T data;
     BSTNode* left;
     BSTNode* right;
+    unsigned priority; // Heap-ordered: a parent's priority is never below its children's
 
-    // Constructor to create a new node
-    BSTNode(T value) : data(value), left(nullptr), right(nullptr) {}
+    // Constructor to create a new node, building the value in place
+    template <typename... Args>
+    explicit BSTNode(unsigned priority, Args&&... args)
+            : data(std::forward<Args>(args)...), left(nullptr), right(nullptr), priority(priority) {}
 };
 
-template <typename T>
+// Binary search tree kept balanced as a treap: every node gets a random priority and rotations keep
+// priorities heap-ordered, so the shape is that of a random BST whatever the insertion order.
+// Sorted input (how catalogs usually arrive) therefore still gives O(log n) expected depth.
+// Header-only so any key type works and comparisons inline; `Compare` orders the values the same way
+// std::set's comparator does, and two values are equal when neither is less than the other.
+template <typename T, typename Compare = std::less<T>>
 class BST {
 private:
-    BSTNode<T>* root;
+    BSTNode<T>* root = nullptr;
+    std::mt19937 rng; // Priority source
+    [[no_unique_address]] Compare compare;
+
+    bool less(const T& a, const T& b) const {
+        return compare(a, b);
+    }
+
+    // Rotations used to restore the heap order on priorities
+    static BSTNode<T>* rotateRight(BSTNode<T>* node) {
+        BSTNode<T>* left = node->left;
+        node->left = left->right;
+        left->right = node;
+        return left;
+    }
+
+    static BSTNode<T>* rotateLeft(BSTNode<T>* node) {
+        BSTNode<T>* right = node->right;
+        node->right = right->left;
+        right->left = node;
+        return right;
+    }
+
+    // Helper function to recursively insert an already built node into the BST.
+    // The node goes in as a leaf and is rotated up while its priority beats its parent's.
+    // `fresh` is set to nullptr once linked; it is left untouched if the value is already present.
+    BSTNode<T>* insert(BSTNode<T>* node, BSTNode<T>*& fresh) {
+        if (node == nullptr) {
+            BSTNode<T>* linked = fresh;
+            fresh = nullptr;
+            return linked;
+        }
+
+        if (less(fresh->data, node->data)) {
+            node->left = insert(node->left, fresh);
+            if (node->left->priority > node->priority) node = rotateRight(node);
+        } else if (less(node->data, fresh->data)) {
+            node->right = insert(node->right, fresh);
+            if (node->right->priority > node->priority) node = rotateLeft(node);
+        }
+
+        return node;
+    }
 
-    // Helper function to recursively insert a value into the BST
-    BSTNode<T>* insert(BSTNode<T>* node, T value);
+    // Join two treaps whose keys are all smaller in `left` than in `right`: the root with the higher
+    // priority stays on top
+    static BSTNode<T>* merge(BSTNode<T>* left, BSTNode<T>* right) {
+        if (!left) return right;
+        if (!right) return left;
 
-    // Helper function to search for a value in the BST
-    BSTNode<T>* search(BSTNode<T>* node, T value);
+        if (left->priority > right->priority) {
+            left->right = merge(left->right, right);
+            return left;
+        }
+        right->left = merge(left, right->left);
+        return right;
+    }
 
-    // Helper function to perform an in-order traversal
-    void inorderTraversal(BSTNode<T>* node);
+    // Helper function to delete a node from the BST.
+    // The found node is replaced by the merge of its two subtrees, which keeps the heap order.
+    BSTNode<T>* deleteNode(BSTNode<T>* root, const T& key) {
+        if (root == nullptr) {
+            return root;
+        }
 
-    // Helper function to delete a node from the BST
-    BSTNode<T>* deleteNode(BSTNode<T>* root, T key);
+        if (less(key, root->data)) {
+            root->left = deleteNode(root->left, key);
+        } else if (less(root->data, key)) {
+            root->right = deleteNode(root->right, key);
+        } else {
+            // Node to be deleted found
+            BSTNode<T>* merged = merge(root->left, root->right);
+            delete root;
+            return merged;
+        }
+        return root;
+    }
 
 public:
+    // In-order forward iterator. The stack holds the ancestors still to be visited, so it uses
+    // O(log n) expected memory and each step is amortized O(1).
+    class Iterator {
+    private:
+        std::vector<BSTNode<T>*> stack;
+
+        void pushLeftSpine(BSTNode<T>* node) {
+            for (; node; node = node->left) stack.push_back(node);
+        }
+
+        friend class BST;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator() = default;
+
+        reference operator*() const { return stack.back()->data; }
+        pointer operator->() const { return &stack.back()->data; }
+
+        Iterator& operator++() {
+            BSTNode<T>* node = stack.back();
+            stack.pop_back();
+            pushLeftSpine(node->right);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            if (stack.empty() || other.stack.empty()) return stack.empty() == other.stack.empty();
+            return stack.back() == other.stack.back();
+        }
+    };
+
     // Constructor to initialize the BST
-    BST();
+    explicit BST(Compare compare = Compare()) : rng(std::random_device{}()), compare(std::move(compare)) {}
+
+    // Free every node without recursion: rotate left children up until there are none, then delete
+    // the node and continue with its right subtree
+    ~BST() {
+        BSTNode<T>* node = root;
+        while (node) {
+            if (node->left) {
+                BSTNode<T>* left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } else {
+                BSTNode<T>* right = node->right;
+                delete node;
+                node = right;
+            }
+        }
+    }
+
+    BST(const BST&) = delete;
+    BST& operator=(const BST&) = delete;
+
+    // Build the value in place and insert it; it is discarded if an equal value is already present
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        BSTNode<T>* fresh = new BSTNode<T>(rng(), std::forward<Args>(args)...);
+        root = insert(root, fresh);
+        delete fresh; // Non-null only for a duplicate
+    }
+    // Complexity: O(log n) expected
 
     // Function to insert a value into the BST
-    void insert(T value);
+    void insert(const T& value) {
+        emplace(value);
+    }
 
-    // Function to search for a value in the BST (now returns a pointer to BSTNode)
-    BSTNode<T>* search(T value);
+    void insert(T&& value) {
+        emplace(std::move(value));
+    }
+
+    // Function to search for a value in the BST (returns a pointer to the node, or nullptr)
+    BSTNode<T>* search(const T& value) {
+        BSTNode<T>* node = root;
+        while (node != nullptr) {
+            if (less(value, node->data)) {
+                node = node->left;
+            } else if (less(node->data, value)) {
+                node = node->right;
+            } else {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+    // Complexity: O(log n) expected
 
     // Function to delete a value from the BST
-    void deleteNode(T value);
+    void deleteNode(const T& value) {
+        root = deleteNode(root, value);
+    }
+    // Complexity: O(log n) expected
+
+    // Call `visit(value)` for every value in ascending order using a Morris traversal: each left
+    // subtree's rightmost node is temporarily threaded back to its in-order successor, so no stack or
+    // recursion is needed (O(1) extra memory) and every thread is removed on the way back up.
+    // The threads are real writes to the tree, so this is non-const: it must not run concurrently with
+    // any other access, and `visit` must neither touch the tree nor start another walk. Const callers
+    // use the iterators instead. If `visit` throws, the walk still finishes (without further visits)
+    // to restore the tree, then rethrows.
+    template <typename Visitor>
+    void forEachInOrder(Visitor&& visit) {
+        std::exception_ptr failure;
+        auto emit = [&](const T& value) {
+            if (failure) return;
+            try {
+                visit(value);
+            } catch (...) {
+                failure = std::current_exception();
+            }
+        };
+
+        BSTNode<T>* node = root;
+        while (node) {
+            if (!node->left) {
+                emit(node->data);
+                node = node->right;
+                continue;
+            }
+
+            BSTNode<T>* predecessor = node->left;
+            while (predecessor->right && predecessor->right != node) {
+                predecessor = predecessor->right;
+            }
 
-    // Function to perform an in-order traversal of the BST
-    void inorderTraversal();
+            if (!predecessor->right) {
+                predecessor->right = node; // Thread back to `node`, then walk the left subtree
+                node = node->left;
+            } else {
+                predecessor->right = nullptr; // Left subtree done: remove the thread
+                emit(node->data);
+                node = node->right;
+            }
+        }
+
+        if (failure) std::rethrow_exception(failure);
+    }
+    // Complexity: O(n) time, O(1) extra space
+
+    // Copy every value in ascending order to `out`, e.g. std::back_inserter or an ostream_iterator.
+    // Read-only, so it walks with the iterator and is safe alongside other readers.
+    template <typename OutputIt>
+    OutputIt copyInOrder(OutputIt out) const {
+        for (const T& value : *this) *out++ = value;
+        return out;
+    }
+    // Complexity: O(n) time, O(log n) expected extra space
+
+    // Function to perform an in-order traversal of the BST, writing space-separated values to `out`
+    void inorderTraversal(std::ostream& out = std::cout) const {
+        for (const T& value : *this) out << value << ' ';
+        out << '\n';
+    }
 
     // Helper function to find the minimum node in the BST
-    BSTNode<T>* findMin(BSTNode<T>* node);
+    BSTNode<T>* findMin(BSTNode<T>* node) {
+        while (node && node->left != nullptr) {
+            node = node->left;
+        }
+        return node;
+    }
+
+    // Iteration in ascending order
+    Iterator begin() const {
+        Iterator it;
+        it.pushLeftSpine(root);
+        return it;
+    }
+
+    Iterator end() const {
+        return Iterator();
+    }
+
+    // First element not less than `value`, or end(). The descent keeps every node where it turned
+    // left: those are exactly the ancestors an in-order walk from the lower bound still has to visit.
+    Iterator lower_bound(const T& value) const {
+        Iterator it;
+        BSTNode<T>* node = root;
+        while (node) {
+            if (less(node->data, value)) {
+                node = node->right;
+            } else {
+                it.stack.push_back(node);
+                node = node->left;
+            }
+        }
+        return it;
+    }
+    // Complexity: O(log n) expected
 };
 
 #endif //PROJECT_ESPRIT_MODEL_C_BST_H
-
@@ -0,0 +1,5 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#include "BucketQueue.h"
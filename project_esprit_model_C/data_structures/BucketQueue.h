@@ -0,0 +1,123 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_BUCKETQUEUE_H
+#define PROJECT_ESPRIT_MODEL_C_BUCKETQUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "PriorityQueue.h"
+
+// Default key of a BucketQueue element: its `cost` member, as in Cell
+struct CostKey {
+    template <typename T>
+    auto operator()(const T& value) const { return value.cost; }
+};
+
+// Monotone min-priority queue for small non-negative integer keys (Dial's algorithm). Elements sit
+// in a circular array of buckets indexed by key, so push is O(1) and pop only scans forward over
+// empty buckets, instead of the O(log n) sifting of PriorityQueue.
+// Pushed keys must not be smaller than the key last popped (unless the queue is empty), which
+// holds for Dijkstra and for A* with a consistent heuristic. The ring grows to a power of two above
+// the spread between the smallest and largest queued key, so a grid search needs about
+// (max step cost + 1) buckets.
+// There is no decrease_key: push the better value again and skip stale entries when they are popped.
+template <typename T = Cell, typename KeyOf = CostKey>
+class BucketQueue {
+private:
+    std::vector<std::vector<T>> buckets; // buckets[key & mask] holds the elements with that key
+    std::size_t mask;
+    std::size_t current = 0; // Smallest queued key, the bucket top() reads from
+    std::size_t highest = 0; // No queued key is larger
+    std::size_t floor = 0;   // Key of the last popped element; pushes may not go below it
+    std::size_t count = 0;
+    [[no_unique_address]] KeyOf keyOf;
+
+    std::size_t keyFor(const T& value) const {
+        auto key = keyOf(value);
+        if (key < 0) throw std::invalid_argument("BucketQueue keys must be non-negative");
+        return static_cast<std::size_t>(key);
+    }
+
+    // Widen the ring so it spans at least `span` consecutive keys, rehoming every element
+    void grow(std::size_t span) {
+        std::size_t size = buckets.size();
+        while (size < span) size *= 2;
+
+        std::vector<std::vector<T>> wider(size);
+        for (auto& bucket : buckets) {
+            for (auto& value : bucket) wider[keyFor(value) & (size - 1)].push_back(std::move(value));
+        }
+        buckets = std::move(wider);
+        mask = size - 1;
+    }
+    // Complexity: O(n + buckets)
+
+    // Move `current` forward to the first non-empty bucket
+    void advance() {
+        if (count == 0) return;
+        while (buckets[current & mask].empty()) ++current;
+    }
+
+public:
+    explicit BucketQueue(std::size_t initialBuckets = 256, KeyOf keyOf = KeyOf()) : keyOf(std::move(keyOf)) {
+        std::size_t size = 1;
+        while (size < initialBuckets) size *= 2;
+        buckets.resize(size);
+        mask = size - 1;
+    }
+
+    void push(const T& value) {
+        std::size_t key = keyFor(value);
+        if (count == 0) {
+            current = highest = key;
+            floor = std::min(floor, key); // An empty queue accepts any key and starts a new run
+        } else if (key < floor) {
+            throw std::invalid_argument("BucketQueue::push key is below the last popped key");
+        } else {
+            current = std::min(current, key);
+            highest = std::max(highest, key);
+        }
+        if (highest - current >= buckets.size()) grow(highest - current + 1);
+
+        buckets[key & mask].push_back(value);
+        ++count;
+    }
+    // Complexity: O(1) amortized
+
+    void pop() {
+        if (count == 0) return;
+        floor = current;
+        buckets[current & mask].pop_back();
+        --count;
+        advance();
+    }
+    // Complexity: O(1) amortized over a monotone run (each bucket is scanned once per lap)
+
+    const T& top() const {
+        if (count == 0) throw std::out_of_range("BucketQueue is empty");
+        return buckets[current & mask].back();
+    }
+
+    void clear() {
+        for (auto& bucket : buckets) bucket.clear();
+        current = highest = floor = 0;
+        count = 0;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+};
+
+
+#endif //PROJECT_ESPRIT_MODEL_C_BUCKETQUEUE_H
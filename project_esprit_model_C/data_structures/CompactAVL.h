@@ -0,0 +1,329 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_COMPACTAVL_H
+#define PROJECT_ESPRIT_MODEL_C_COMPACTAVL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// AVL tree whose nodes live in one contiguous vector and link to each other by 32-bit indices.
+// Compared to AVL's individually allocated nodes with two 64-bit pointers, a node here is
+// key + value + 9 bytes, so roughly twice as many fit per cache line for small keys. Removed slots
+// are chained into a free list and reused by later inserts.
+// Nothing inside the tree is an address, so copies and moves are plain vector copies and, for
+// trivially copyable Key and Value, the node array can be dumped byte-for-byte via nodeStorage().
+// Shares the query API of YFastTrie and BPlusTree so it can be used as an OrderedIndex backend.
+// Pointers returned by search/predecessor/successor are invalidated by the next insert.
+template <typename Key, typename Value>
+class CompactAVL {
+public:
+    using Index = std::uint32_t;
+    using Entry = std::optional<std::pair<Key, Value*>>;
+
+    static constexpr Index NIL = std::numeric_limits<Index>::max();
+
+    struct Node {
+        Key key;
+        Value value;
+        Index left;
+        Index right;
+        std::uint8_t height;
+    };
+
+private:
+    // 1.44 log2(2^32) < 48, so heights fit a byte and this path stack covers any tree
+    static constexpr int MAX_HEIGHT = 64;
+
+    std::vector<Node> nodes;
+    Index root = NIL;
+    Index freeList = NIL; // Released slots, chained through `left`
+    std::size_t count = 0;
+
+    int height(Index node) const {
+        return node == NIL ? 0 : nodes[node].height;
+    }
+
+    int balanceFactor(Index node) const {
+        return height(nodes[node].left) - height(nodes[node].right);
+    }
+
+    void updateHeight(Index node) {
+        nodes[node].height = static_cast<std::uint8_t>(std::max(height(nodes[node].left), height(nodes[node].right)) + 1);
+    }
+
+    Index rotateRight(Index y) {
+        Index x = nodes[y].left;
+        nodes[y].left = nodes[x].right;
+        nodes[x].right = y;
+        updateHeight(y);
+        updateHeight(x);
+        return x;
+    }
+
+    Index rotateLeft(Index x) {
+        Index y = nodes[x].right;
+        nodes[x].right = nodes[y].left;
+        nodes[y].left = x;
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    Index balance(Index node) {
+        updateHeight(node);
+        int bf = balanceFactor(node);
+
+        // Left-heavy
+        if (bf > 1) {
+            if (balanceFactor(nodes[node].left) < 0) {
+                nodes[node].left = rotateLeft(nodes[node].left);
+            }
+            return rotateRight(node);
+        }
+
+        // Right-heavy
+        if (bf < -1) {
+            if (balanceFactor(nodes[node].right) > 0) {
+                nodes[node].right = rotateRight(nodes[node].right);
+            }
+            return rotateLeft(node);
+        }
+
+        return node;
+    }
+
+    Index allocate(Key key, Value value) {
+        Node node{key, std::move(value), NIL, NIL, 1};
+        if (freeList != NIL) {
+            Index slot = freeList;
+            freeList = nodes[slot].left;
+            nodes[slot] = std::move(node);
+            return slot;
+        }
+        if (nodes.size() == NIL) {
+            throw std::length_error("CompactAVL cannot hold more than 2^32 - 1 nodes");
+        }
+        nodes.push_back(std::move(node));
+        return static_cast<Index>(nodes.size() - 1);
+    }
+
+    void release(Index node) {
+        nodes[node].value = Value(); // Drop resources held by the value now, not on reuse
+        nodes[node].left = freeList;
+        freeList = node;
+    }
+
+    // Point the parent of path[i] (or the root) at `child`
+    void relink(const Index path[], int i, Index oldChild, Index child) {
+        if (i == 0) {
+            root = child;
+        } else if (nodes[path[i - 1]].left == oldChild) {
+            nodes[path[i - 1]].left = child;
+        } else {
+            nodes[path[i - 1]].right = child;
+        }
+    }
+
+    // Rebalance path[top] .. path[0] (deepest first), stopping once a subtree keeps its root and height
+    void rebalancePath(const Index path[], int top) {
+        for (int i = top; i >= 0; --i) {
+            Index node = path[i];
+            int oldHeight = nodes[node].height;
+            Index balanced = balance(node);
+            if (balanced != node) relink(path, i, node, balanced);
+            if (balanced == node && nodes[balanced].height == oldHeight) break;
+        }
+    }
+    // Complexity: O(log n)
+
+    void displayHelper(Index node, int depth) const {
+        if (node == NIL) return;
+
+        displayHelper(nodes[node].right, depth + 1);
+        std::cout << std::string(depth * 4, ' ') << nodes[node].key << ": " << nodes[node].value
+                  << " (Height: " << int(nodes[node].height) << ")\n";
+        displayHelper(nodes[node].left, depth + 1);
+    }
+
+public:
+    CompactAVL() = default;
+
+    void reserve(std::size_t capacity) {
+        nodes.reserve(capacity);
+    }
+
+    void insert(Key key, Value value) {
+        Index path[MAX_HEIGHT];
+        int depth = 0;
+        Index node = root;
+
+        while (node != NIL) {
+            path[depth++] = node;
+            if (key < nodes[node].key) {
+                node = nodes[node].left;
+            } else if (nodes[node].key < key) {
+                node = nodes[node].right;
+            } else {
+                nodes[node].value = std::move(value); // Update value if key already exists
+                return;
+            }
+        }
+
+        // Allocate before linking: push_back may move the node array, indices stay valid
+        Index fresh = allocate(key, std::move(value));
+        ++count;
+        if (depth == 0) {
+            root = fresh;
+            return;
+        }
+
+        Index parent = path[depth - 1];
+        if (key < nodes[parent].key) {
+            nodes[parent].left = fresh;
+        } else {
+            nodes[parent].right = fresh;
+        }
+        rebalancePath(path, depth - 1);
+    }
+    // Complexity: O(log n), amortized O(1) allocation
+
+    void remove(Key key) {
+        Index path[MAX_HEIGHT];
+        int depth = 0;
+        Index node = root;
+
+        while (node != NIL) {
+            if (key < nodes[node].key) {
+                path[depth++] = node;
+                node = nodes[node].left;
+            } else if (nodes[node].key < key) {
+                path[depth++] = node;
+                node = nodes[node].right;
+            } else {
+                break;
+            }
+        }
+        if (node == NIL) return; // Key not found
+
+        Index doomed = node;
+        if (nodes[node].left != NIL && nodes[node].right != NIL) {
+            // Two children: move the in-order successor's entry here and unlink the successor instead
+            path[depth++] = node;
+            doomed = nodes[node].right;
+            while (nodes[doomed].left != NIL) {
+                path[depth++] = doomed;
+                doomed = nodes[doomed].left;
+            }
+            nodes[node].key = std::move(nodes[doomed].key);
+            nodes[node].value = std::move(nodes[doomed].value);
+        }
+
+        // `doomed` has at most one child
+        Index child = nodes[doomed].left != NIL ? nodes[doomed].left : nodes[doomed].right;
+        relink(path, depth, doomed, child);
+
+        release(doomed);
+        --count;
+        rebalancePath(path, depth - 1);
+    }
+    // Complexity: O(log n)
+
+    Value* search(Key key) {
+        Index node = root;
+        while (node != NIL) {
+            if (key < nodes[node].key) {
+                node = nodes[node].left;
+            } else if (nodes[node].key < key) {
+                node = nodes[node].right;
+            } else {
+                return &nodes[node].value;
+            }
+        }
+        return nullptr;
+    }
+    // Complexity: O(log n)
+
+    // Largest key strictly smaller than `key`. Like AVL::pred, the next child is picked by index.
+    Entry predecessor(Key key) {
+        Index candidate = NIL;
+        Index node = root;
+        while (node != NIL) {
+            Index children[2] = {nodes[node].left, nodes[node].right};
+            bool goRight = nodes[node].key < key;
+            if (goRight) candidate = node;
+            node = children[goRight];
+        }
+        if (candidate == NIL) return std::nullopt;
+        return std::pair<Key, Value*>(nodes[candidate].key, &nodes[candidate].value);
+    }
+    // Complexity: O(log n)
+
+    // Smallest key strictly greater than `key`
+    Entry successor(Key key) {
+        Index candidate = NIL;
+        Index node = root;
+        while (node != NIL) {
+            Index children[2] = {nodes[node].left, nodes[node].right};
+            bool goLeft = key < nodes[node].key;
+            if (goLeft) candidate = node;
+            node = children[!goLeft];
+        }
+        if (candidate == NIL) return std::nullopt;
+        return std::pair<Key, Value*>(nodes[candidate].key, &nodes[candidate].value);
+    }
+    // Complexity: O(log n)
+
+    // Batched predecessor queries, answered in probe order
+    std::vector<Entry> predecessor_many(std::span<const Key> keys) {
+        std::vector<Entry> results;
+        results.reserve(keys.size());
+        for (const Key& key : keys) {
+            results.push_back(predecessor(key));
+        }
+        return results;
+    }
+    // Complexity: O(m log n)
+
+    Key findMinKey() const {
+        Index node = root;
+        while (node != NIL && nodes[node].left != NIL) node = nodes[node].left;
+        return node != NIL ? nodes[node].key : Key();
+    }
+
+    Key findMaxKey() const {
+        Index node = root;
+        while (node != NIL && nodes[node].right != NIL) node = nodes[node].right;
+        return node != NIL ? nodes[node].key : Key();
+    }
+
+    std::size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+
+    void clear() {
+        nodes.clear();
+        root = NIL;
+        freeList = NIL;
+        count = 0;
+    }
+
+    // Raw node array including free slots, e.g. for serialization. rootIndex() names the root slot.
+    std::span<const Node> nodeStorage() const { return nodes; }
+    Index rootIndex() const { return root; }
+
+    void display() const {
+        std::cout << "CompactAVL Tree Contents:\n";
+        displayHelper(root, 0);
+    }
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_COMPACTAVL_H
@@ -0,0 +1,155 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_HIERARCHICALBITSET_H
+#define PROJECT_ESPRIT_MODEL_C_HIERARCHICALBITSET_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Integer successor set over the universe [0, 2^Bits), laid out as a 64-ary van Emde Boas style summary.
+// Level 0 holds one bit per key; every bit of level l + 1 records whether the matching 64-bit word of
+// level l is non-empty. pred/succ climb until a word has a candidate bit, then descend with
+// countl_zero/countr_zero, touching at most one word per level (ceil(Bits / 6) levels).
+// Intended for dense 16-24 bit universes such as item codes or grid cells.
+template <unsigned Bits>
+class HierarchicalBitset {
+    static_assert(Bits >= 1 && Bits <= 32, "HierarchicalBitset supports universes of up to 2^32 keys");
+
+private:
+    static constexpr unsigned LEVELS = (Bits + 5) / 6;
+    static constexpr std::uint64_t UNIVERSE = std::uint64_t(1) << Bits;
+
+    std::array<std::vector<std::uint64_t>, LEVELS> levels;
+    std::size_t count = 0;
+
+    // Bits strictly above / strictly below position `bit` of a word
+    static std::uint64_t maskAbove(unsigned bit) {
+        return bit == 63 ? 0 : ~std::uint64_t(0) << (bit + 1);
+    }
+
+    static std::uint64_t maskBelow(unsigned bit) {
+        return (std::uint64_t(1) << bit) - 1;
+    }
+
+    // Smallest key >= key, or nothing
+    std::optional<std::uint32_t> findAtOrAbove(std::uint64_t key) const {
+        if (key >= UNIVERSE) return std::nullopt;
+
+        std::uint64_t index = key;
+        std::uint64_t word = levels[0][index >> 6] & (~std::uint64_t(0) << (index & 63));
+        unsigned level = 0;
+
+        while (!word) {
+            if (++level == LEVELS) return std::nullopt;
+            index >>= 6;
+            word = levels[level][index >> 6] & maskAbove(static_cast<unsigned>(index & 63));
+        }
+
+        index = (index & ~std::uint64_t(63)) | static_cast<unsigned>(std::countr_zero(word));
+        while (level-- > 0) {
+            index = (index << 6) | static_cast<unsigned>(std::countr_zero(levels[level][index]));
+        }
+        return static_cast<std::uint32_t>(index);
+    }
+
+    // Largest key <= key, or nothing
+    std::optional<std::uint32_t> findAtOrBelow(std::uint64_t key) const {
+        std::uint64_t index = key;
+        std::uint64_t word = levels[0][index >> 6] & (maskBelow(index & 63) | (std::uint64_t(1) << (index & 63)));
+        unsigned level = 0;
+
+        while (!word) {
+            if (++level == LEVELS) return std::nullopt;
+            index >>= 6;
+            word = levels[level][index >> 6] & maskBelow(static_cast<unsigned>(index & 63));
+        }
+
+        index = (index & ~std::uint64_t(63)) | static_cast<unsigned>(63 - std::countl_zero(word));
+        while (level-- > 0) {
+            index = (index << 6) | static_cast<unsigned>(63 - std::countl_zero(levels[level][index]));
+        }
+        return static_cast<std::uint32_t>(index);
+    }
+
+public:
+    HierarchicalBitset() {
+        std::uint64_t words = UNIVERSE;
+        for (auto& level : levels) {
+            words = (words + 63) / 64;
+            level.assign(words, 0);
+        }
+    }
+
+    void insert(std::uint32_t key) {
+        if (key >= UNIVERSE || contains(key)) return;
+        ++count;
+
+        std::uint64_t index = key;
+        for (auto& level : levels) {
+            std::uint64_t& word = level[index >> 6];
+            bool wasEmpty = word == 0;
+            word |= std::uint64_t(1) << (index & 63);
+            if (!wasEmpty) return; // Summaries already mark this word as non-empty
+            index >>= 6;
+        }
+    }
+    // Complexity: O(Bits / 6)
+
+    void remove(std::uint32_t key) {
+        if (!contains(key)) return;
+        --count;
+
+        std::uint64_t index = key;
+        for (auto& level : levels) {
+            std::uint64_t& word = level[index >> 6];
+            word &= ~(std::uint64_t(1) << (index & 63));
+            if (word) return; // Word still non-empty, summaries unchanged
+            index >>= 6;
+        }
+    }
+    // Complexity: O(Bits / 6)
+
+    bool contains(std::uint32_t key) const {
+        return key < UNIVERSE && (levels[0][key >> 6] >> (key & 63)) & 1;
+    }
+    // Complexity: O(1)
+
+    // Largest key strictly smaller than `key`
+    std::optional<std::uint32_t> pred(std::uint32_t key) const {
+        if (key == 0) return std::nullopt;
+        return findAtOrBelow(std::min<std::uint64_t>(key - 1, UNIVERSE - 1));
+    }
+    // Complexity: O(Bits / 6)
+
+    // Smallest key strictly greater than `key`
+    std::optional<std::uint32_t> succ(std::uint32_t key) const {
+        return findAtOrAbove(std::uint64_t(key) + 1);
+    }
+    // Complexity: O(Bits / 6)
+
+    std::optional<std::uint32_t> findMin() const {
+        return findAtOrAbove(0);
+    }
+
+    std::optional<std::uint32_t> findMax() const {
+        return findAtOrBelow(UNIVERSE - 1);
+    }
+
+    std::size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+
+    void clear() {
+        for (auto& level : levels) {
+            std::fill(level.begin(), level.end(), 0);
+        }
+        count = 0;
+    }
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_HIERARCHICALBITSET_H
@@ -0,0 +1,26 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_ORDEREDINDEX_H
+#define PROJECT_ESPRIT_MODEL_C_ORDEREDINDEX_H
+
+#include <concepts>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Query API shared by the ordered map backends (YFastTrie, BPlusTree, CompactAVL).
+// Code written against OrderedIndex can pick the backend per workload by changing one type.
+template <typename Index, typename Key, typename Value>
+concept OrderedIndex = requires(Index& index, Key key, Value value, std::span<const Key> probes) {
+    index.insert(key, value);
+    index.remove(key);
+    { index.search(key) } -> std::same_as<Value*>;
+    { index.predecessor(key) } -> std::same_as<std::optional<std::pair<Key, Value*>>>;
+    { index.successor(key) } -> std::same_as<std::optional<std::pair<Key, Value*>>>;
+    { index.predecessor_many(probes) } -> std::same_as<std::vector<std::optional<std::pair<Key, Value*>>>>;
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_ORDEREDINDEX_H
@@ -0,0 +1,217 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_PERSISTENTAVL_H
+#define PROJECT_ESPRIT_MODEL_C_PERSISTENTAVL_H
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+// Persistent (immutable) AVL tree for versioned views, e.g. item prices before and after a market tick.
+// A PersistentAVL value is one version: insert/remove never modify it but return a new version that
+// path-copies the O(log n) nodes from the root to the change and shares every other subtree with the
+// old one. Nodes are reference counted, so a subtree is freed once no version references it.
+// Copying a version (taking a snapshot) is O(1). Versions are safe to read from several threads.
+template <typename Key, typename Value>
+class PersistentAVL {
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node {
+        Key key;
+        Value value;
+        int height;
+        int size; // Number of nodes in this subtree
+        NodePtr left;
+        NodePtr right;
+    };
+
+    NodePtr root;
+
+    explicit PersistentAVL(NodePtr root) : root(std::move(root)) {}
+
+    static int height(const NodePtr& node) {
+        return node ? node->height : 0;
+    }
+
+    static int size(const NodePtr& node) {
+        return node ? node->size : 0;
+    }
+
+    static NodePtr makeNode(const Key& key, const Value& value, NodePtr left, NodePtr right) {
+        int nodeHeight = std::max(height(left), height(right)) + 1;
+        int nodeSize = size(left) + size(right) + 1;
+        return std::make_shared<const Node>(Node{key, value, nodeHeight, nodeSize, std::move(left), std::move(right)});
+    }
+
+    // New node over (left, key, right) whose subtree heights differ by at most 2, rebalanced with a
+    // single or double rotation. Rotations allocate fresh nodes instead of relinking shared ones.
+    static NodePtr balance(const Key& key, const Value& value, NodePtr left, NodePtr right) {
+        if (height(left) > height(right) + 1) {
+            if (height(left->left) >= height(left->right)) {
+                return makeNode(left->key, left->value, left->left, makeNode(key, value, left->right, std::move(right)));
+            }
+            const NodePtr& pivot = left->right;
+            return makeNode(pivot->key, pivot->value, makeNode(left->key, left->value, left->left, pivot->left),
+                            makeNode(key, value, pivot->right, std::move(right)));
+        }
+
+        if (height(right) > height(left) + 1) {
+            if (height(right->right) >= height(right->left)) {
+                return makeNode(right->key, right->value, makeNode(key, value, std::move(left), right->left), right->right);
+            }
+            const NodePtr& pivot = right->left;
+            return makeNode(pivot->key, pivot->value, makeNode(key, value, std::move(left), pivot->left),
+                            makeNode(right->key, right->value, pivot->right, right->right));
+        }
+
+        return makeNode(key, value, std::move(left), std::move(right));
+    }
+
+    static NodePtr insert(const NodePtr& node, const Key& key, const Value& value) {
+        if (!node) return makeNode(key, value, nullptr, nullptr);
+
+        if (key < node->key) {
+            return balance(node->key, node->value, insert(node->left, key, value), node->right);
+        }
+        if (node->key < key) {
+            return balance(node->key, node->value, node->left, insert(node->right, key, value));
+        }
+        return makeNode(key, value, node->left, node->right); // Update value if key already exists
+    }
+    // Complexity: O(log n) time and new nodes
+
+    // Copy of the subtree without its minimum, which is returned in `min`
+    static NodePtr removeMin(const NodePtr& node, NodePtr& min) {
+        if (!node->left) {
+            min = node;
+            return node->right;
+        }
+        return balance(node->key, node->value, removeMin(node->left, min), node->right);
+    }
+
+    // Returns `node` itself when the key is absent, so a no-op removal allocates nothing
+    static NodePtr remove(const NodePtr& node, const Key& key) {
+        if (!node) return node;
+
+        if (key < node->key) {
+            NodePtr left = remove(node->left, key);
+            if (left == node->left) return node;
+            return balance(node->key, node->value, std::move(left), node->right);
+        }
+        if (node->key < key) {
+            NodePtr right = remove(node->right, key);
+            if (right == node->right) return node;
+            return balance(node->key, node->value, node->left, std::move(right));
+        }
+
+        if (!node->left) return node->right;
+        if (!node->right) return node->left;
+
+        NodePtr min;
+        NodePtr right = removeMin(node->right, min);
+        return balance(min->key, min->value, node->left, std::move(right));
+    }
+    // Complexity: O(log n) time and new nodes
+
+    static void displayHelper(const Node* node, int depth) {
+        if (!node) return;
+
+        displayHelper(node->right.get(), depth + 1);
+        std::cout << std::string(depth * 4, ' ') << node->key << ": " << node->value << " (Height: " << node->height << ")\n";
+        displayHelper(node->left.get(), depth + 1);
+    }
+
+public:
+    PersistentAVL() = default;
+
+    // New version with `key` mapped to `value`; this version is unchanged
+    [[nodiscard]] PersistentAVL insert(const Key& key, const Value& value) const {
+        return PersistentAVL(insert(root, key, value));
+    }
+    // Complexity: O(log n)
+
+    // New version without `key`; this version is unchanged
+    [[nodiscard]] PersistentAVL remove(const Key& key) const {
+        return PersistentAVL(remove(root, key));
+    }
+    // Complexity: O(log n)
+
+    const Value* search(const Key& key) const {
+        const Node* node = root.get();
+        while (node) {
+            if (key < node->key) {
+                node = node->left.get();
+            } else if (node->key < key) {
+                node = node->right.get();
+            } else {
+                return &node->value;
+            }
+        }
+        return nullptr;
+    }
+    // Complexity: O(log n)
+
+    // Largest key strictly smaller than `key`
+    std::optional<std::pair<Key, const Value*>> predecessor(const Key& key) const {
+        const Node* candidate = nullptr;
+        for (const Node* node = root.get(); node;) {
+            if (node->key < key) {
+                candidate = node;
+                node = node->right.get();
+            } else {
+                node = node->left.get();
+            }
+        }
+        if (!candidate) return std::nullopt;
+        return std::pair<Key, const Value*>(candidate->key, &candidate->value);
+    }
+    // Complexity: O(log n)
+
+    // Smallest key strictly greater than `key`
+    std::optional<std::pair<Key, const Value*>> successor(const Key& key) const {
+        const Node* candidate = nullptr;
+        for (const Node* node = root.get(); node;) {
+            if (key < node->key) {
+                candidate = node;
+                node = node->left.get();
+            } else {
+                node = node->right.get();
+            }
+        }
+        if (!candidate) return std::nullopt;
+        return std::pair<Key, const Value*>(candidate->key, &candidate->value);
+    }
+    // Complexity: O(log n)
+
+    Key findMinKey() const {
+        const Node* node = root.get();
+        while (node && node->left) node = node->left.get();
+        return node ? node->key : Key();
+    }
+
+    Key findMaxKey() const {
+        const Node* node = root.get();
+        while (node && node->right) node = node->right.get();
+        return node ? node->key : Key();
+    }
+
+    int size() const { return size(root); }
+    bool isEmpty() const { return root == nullptr; }
+
+    // True when both versions share the same root, i.e. one was copied from the other without updates
+    bool sharesRootWith(const PersistentAVL& other) const { return root == other.root; }
+
+    void display() const {
+        std::cout << "Persistent AVL Tree Contents:\n";
+        displayHelper(root.get(), 0);
+    }
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_PERSISTENTAVL_H
@@ -6,68 +6,211 @@
 #define PROJECT_ESPRIT_MODEL_C_PRIORITYQUEUE_H
 
 
-#include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
-using namespace std;
-
 struct Cell {
     int row, col, cost;
     bool operator<(const Cell& other) const { return cost < other.cost; }
 };
 
+// Min-heap with Arity children per node (4 by default): top() is the element no other element is
+// `Compare`-less than. A wider node makes the heap shallower, so push/decrease_key walk fewer levels
+// and pop scans Arity contiguous children per level, which stays inside one or two cache lines.
+// Every push returns a Handle that stays valid until the element is popped; a position index maps
+// handles to heap slots so decrease_key can move an element in place instead of pushing a duplicate.
+// Slots of popped elements are recycled by later pushes, but each reuse bumps the slot's generation,
+// which is part of the Handle: a stale handle is rejected instead of reaching the slot's new element.
+template <typename T = Cell, std::size_t Arity = 4, typename Compare = std::less<T>>
 class PriorityQueue {
+    static_assert(Arity >= 2, "PriorityQueue needs at least two children per node");
+
+public:
+    using Handle = std::uint64_t; // Slot index in the low 32 bits, slot generation in the high 32
+
 private:
-    vector<Cell> heap;
-
-    void heapifyUp(int index) {
-        if (index == 0) return;
-        int parent = (index - 1) / 2;
-        if (heap[index].cost < heap[parent].cost) {
-            swap(heap[index], heap[parent]);
-            heapifyUp(parent);
+    static constexpr std::uint32_t NOT_IN_HEAP = UINT32_MAX;
+
+    struct Entry {
+        T value;
+        std::uint32_t slot;
+    };
+
+    struct Slot {
+        std::uint32_t position;   // Heap index of the slot's element, NOT_IN_HEAP once popped
+        std::uint32_t generation; // Bumped every time the slot is freed
+    };
+
+    std::vector<Entry> heap;
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots; // Popped slots available for reuse
+    [[no_unique_address]] Compare compare;
+
+    std::uint32_t acquireSlot() {
+        if (!freeSlots.empty()) {
+            std::uint32_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
         }
+        slots.push_back({NOT_IN_HEAP, 0});
+        return static_cast<std::uint32_t>(slots.size() - 1);
     }
 
-    void heapifyDown(int index) {
-        int leftChild = 2 * index + 1;
-        int rightChild = 2 * index + 2;
-        int smallest = index;
+    // Free a slot; the new generation invalidates every handle issued for it so far
+    void releaseSlot(std::uint32_t slot) {
+        slots[slot].position = NOT_IN_HEAP;
+        ++slots[slot].generation;
+        freeSlots.push_back(slot);
+    }
 
-        if (leftChild < heap.size() && heap[leftChild].cost < heap[smallest].cost) {
-            smallest = leftChild;
-        }
-        if (rightChild < heap.size() && heap[rightChild].cost < heap[smallest].cost) {
-            smallest = rightChild;
+    Handle handleOf(std::uint32_t slot) const {
+        return static_cast<Handle>(slots[slot].generation) << 32 | slot;
+    }
+
+    // Heap index of the element behind `handle`, or NOT_IN_HEAP if it was popped or never issued
+    std::uint32_t locate(Handle handle) const {
+        std::uint64_t slot = handle & UINT32_MAX;
+        if (slot >= slots.size() || slots[slot].generation != handle >> 32) return NOT_IN_HEAP;
+        return slots[slot].position;
+    }
+
+    // Move the entry at `index` up to its place, shifting parents down into the hole
+    void heapifyUp(std::size_t index) {
+        Entry entry = std::move(heap[index]);
+        while (index > 0) {
+            std::size_t parent = (index - 1) / Arity;
+            if (!compare(entry.value, heap[parent].value)) break;
+            heap[index] = std::move(heap[parent]);
+            slots[heap[index].slot].position = static_cast<std::uint32_t>(index);
+            index = parent;
         }
-        if (smallest != index) {
-            swap(heap[index], heap[smallest]);
-            heapifyDown(smallest);
+        heap[index] = std::move(entry);
+        slots[heap[index].slot].position = static_cast<std::uint32_t>(index);
+    }
+    // Complexity: O(log_Arity n)
+
+    // Move the entry at `index` down to its place, shifting the best child up into the hole
+    void heapifyDown(std::size_t index) {
+        std::size_t size = heap.size();
+        Entry entry = std::move(heap[index]);
+        while (true) {
+            std::size_t first = index * Arity + 1;
+            if (first >= size) break;
+
+            std::size_t last = std::min(first + Arity, size);
+            std::size_t best = first;
+            for (std::size_t child = first + 1; child < last; ++child) {
+                if (compare(heap[child].value, heap[best].value)) best = child;
+            }
+            if (!compare(heap[best].value, entry.value)) break;
+
+            heap[index] = std::move(heap[best]);
+            slots[heap[index].slot].position = static_cast<std::uint32_t>(index);
+            index = best;
         }
+        heap[index] = std::move(entry);
+        slots[heap[index].slot].position = static_cast<std::uint32_t>(index);
     }
+    // Complexity: O(Arity log_Arity n)
 
 public:
-    void push(const Cell& cell) {
-        heap.push_back(cell);
+    explicit PriorityQueue(Compare compare = Compare()) : compare(std::move(compare)) {}
+
+    Handle push(const T& value) {
+        std::uint32_t slot = acquireSlot();
+        heap.push_back({value, slot});
         heapifyUp(heap.size() - 1);
+        return handleOf(slot);
+    }
+    // Complexity: O(log_Arity n)
+
+    // Push many elements at once: append them, then restore the heap bottom-up (Floyd's method),
+    // which is O(n + k) instead of O(k log n) for k separate pushes
+    template <typename InputIt>
+    void push_range(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            std::uint32_t slot = acquireSlot();
+            slots[slot].position = static_cast<std::uint32_t>(heap.size());
+            heap.push_back({*first, slot});
+        }
+        if (heap.size() < 2) return;
+        for (std::size_t index = (heap.size() - 2) / Arity + 1; index-- > 0;) {
+            heapifyDown(index);
+        }
     }
+    // Complexity: O(n + k)
 
     void pop() {
         if (heap.empty()) return;
-        heap[0] = heap.back();
+
+        releaseSlot(heap.front().slot);
+
+        heap.front() = std::move(heap.back());
         heap.pop_back();
-        heapifyDown(0);
+        if (!heap.empty()) heapifyDown(0);
     }
+    // Complexity: O(Arity log_Arity n)
 
-    Cell top() const {
-        if (heap.empty()) throw out_of_range("PriorityQueue is empty");
-        return heap[0];
+    const T& top() const {
+        if (heap.empty()) throw std::out_of_range("PriorityQueue is empty");
+        return heap.front().value;
+    }
+
+    // Handle of the element returned by top()
+    Handle topHandle() const {
+        if (heap.empty()) throw std::out_of_range("PriorityQueue is empty");
+        return handleOf(heap.front().slot);
+    }
+
+    // Replace the element behind `handle` with a value that is not worse, and move it up
+    void decrease_key(Handle handle, const T& value) {
+        std::uint32_t index = locate(handle);
+        if (index == NOT_IN_HEAP) throw std::out_of_range("PriorityQueue handle is not in the queue");
+
+        if (compare(heap[index].value, value)) {
+            throw std::invalid_argument("PriorityQueue::decrease_key cannot make an element worse");
+        }
+        heap[index].value = value;
+        heapifyUp(index);
+    }
+    // Complexity: O(log_Arity n)
+
+    // False once the element has been popped, even if its slot now holds another element
+    bool contains(Handle handle) const {
+        return locate(handle) != NOT_IN_HEAP;
+    }
+
+    const T& value(Handle handle) const {
+        std::uint32_t index = locate(handle);
+        if (index == NOT_IN_HEAP) throw std::out_of_range("PriorityQueue handle is not in the queue");
+        return heap[index].value;
+    }
+
+    void reserve(std::size_t capacity) {
+        heap.reserve(capacity);
+        slots.reserve(capacity);
+    }
+
+    // Slots are kept (with new generations) so handles from before the clear stay rejected
+    void clear() {
+        for (const Entry& entry : heap) releaseSlot(entry.slot);
+        heap.clear();
     }
 
     bool empty() const {
         return heap.empty();
     }
 
+    std::size_t size() const {
+        return heap.size();
+    }
+
 };
 
 
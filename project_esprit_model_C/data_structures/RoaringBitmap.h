@@ -0,0 +1,325 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_ROARINGBITMAP_H
+#define PROJECT_ESPRIT_MODEL_C_ROARINGBITMAP_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// Compressed set of 32-bit integers in the style of Roaring bitmaps. Values are grouped by their
+// high 16 bits into containers of 2^16 values each, and every container picks the cheaper form:
+//  - array:  sorted uint16 low halves, for up to ARRAY_LIMIT values (2 bytes per value)
+//  - bitmap: 1024 64-bit words (8 KB flat) once it holds more
+// Sparse sets cost about 2 bytes per value and dense ones 1 bit per possible value. Set operations
+// work container by container: bitmap with bitmap is a straight word loop (AND/OR/ANDNOT plus
+// popcount) that the compiler vectorizes, array with bitmap probes bits, array with array merges.
+// Results are converted back to arrays when they get sparse.
+class RoaringBitmap {
+private:
+    static constexpr std::size_t ARRAY_LIMIT = 4096; // Past this an array is larger than a bitmap
+    static constexpr std::size_t BITMAP_WORDS = 1024;
+
+    struct Container {
+        std::vector<std::uint16_t> values; // Array form, used while `bits` is empty
+        std::vector<std::uint64_t> bits;   // Bitmap form
+        std::uint32_t cardinality = 0;
+
+        bool isBitmap() const { return !bits.empty(); }
+
+        bool contains(std::uint16_t low) const {
+            if (isBitmap()) return (bits[low >> 6] >> (low & 63)) & 1;
+            return std::binary_search(values.begin(), values.end(), low);
+        }
+
+        void add(std::uint16_t low) {
+            if (isBitmap()) {
+                std::uint64_t& word = bits[low >> 6];
+                std::uint64_t bit = std::uint64_t(1) << (low & 63);
+                cardinality += (word & bit) ? 0 : 1;
+                word |= bit;
+                return;
+            }
+            auto it = std::lower_bound(values.begin(), values.end(), low);
+            if (it != values.end() && *it == low) return;
+            values.insert(it, low);
+            ++cardinality;
+            if (cardinality > ARRAY_LIMIT) toBitmap();
+        }
+
+        void toBitmap() {
+            bits.assign(BITMAP_WORDS, 0);
+            for (std::uint16_t low : values) bits[low >> 6] |= std::uint64_t(1) << (low & 63);
+            values.clear();
+            values.shrink_to_fit();
+        }
+
+        // Recount a bitmap and fall back to an array if it got sparse
+        void normalize() {
+            if (!isBitmap()) return;
+            cardinality = 0;
+            for (std::uint64_t word : bits) cardinality += static_cast<std::uint32_t>(std::popcount(word));
+            if (cardinality > ARRAY_LIMIT) return;
+
+            values.reserve(cardinality);
+            for (std::size_t word = 0; word < BITMAP_WORDS; ++word) {
+                for (std::uint64_t rest = bits[word]; rest; rest &= rest - 1) {
+                    values.push_back(static_cast<std::uint16_t>(word * 64 + std::countr_zero(rest)));
+                }
+            }
+            bits.clear();
+            bits.shrink_to_fit();
+        }
+    };
+
+    std::vector<std::uint16_t> keys; // High halves, sorted; keys[i] owns containers[i]
+    std::vector<Container> containers;
+
+    static Container intersect(const Container& a, const Container& b) {
+        Container result;
+        if (a.isBitmap() && b.isBitmap()) {
+            result.bits.resize(BITMAP_WORDS);
+            for (std::size_t word = 0; word < BITMAP_WORDS; ++word) result.bits[word] = a.bits[word] & b.bits[word];
+            result.normalize();
+        } else if (a.isBitmap() || b.isBitmap()) {
+            const Container& array = a.isBitmap() ? b : a;
+            const Container& bitmap = a.isBitmap() ? a : b;
+            for (std::uint16_t low : array.values) {
+                if (bitmap.contains(low)) result.values.push_back(low);
+            }
+        } else {
+            std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                                  std::back_inserter(result.values));
+        }
+        if (!result.isBitmap()) result.cardinality = static_cast<std::uint32_t>(result.values.size());
+        return result;
+    }
+    // Complexity: O(1024) for two bitmaps, O(array) otherwise
+
+    static Container unite(const Container& a, const Container& b) {
+        Container result;
+        if (!a.isBitmap() && !b.isBitmap() && a.cardinality + b.cardinality <= ARRAY_LIMIT) {
+            std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                           std::back_inserter(result.values));
+            result.cardinality = static_cast<std::uint32_t>(result.values.size());
+            return result;
+        }
+
+        result.bits.assign(BITMAP_WORDS, 0);
+        for (const Container* side : {&a, &b}) {
+            if (side->isBitmap()) {
+                for (std::size_t word = 0; word < BITMAP_WORDS; ++word) result.bits[word] |= side->bits[word];
+            } else {
+                for (std::uint16_t low : side->values) result.bits[low >> 6] |= std::uint64_t(1) << (low & 63);
+            }
+        }
+        result.normalize();
+        return result;
+    }
+    // Complexity: O(1024 + arrays)
+
+    // Values of a that are not in b
+    static Container subtract(const Container& a, const Container& b) {
+        Container result;
+        if (!a.isBitmap()) {
+            if (b.isBitmap()) {
+                for (std::uint16_t low : a.values) {
+                    if (!b.contains(low)) result.values.push_back(low);
+                }
+            } else {
+                std::set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                                    std::back_inserter(result.values));
+            }
+            result.cardinality = static_cast<std::uint32_t>(result.values.size());
+            return result;
+        }
+
+        result.bits = a.bits;
+        if (b.isBitmap()) {
+            for (std::size_t word = 0; word < BITMAP_WORDS; ++word) result.bits[word] &= ~b.bits[word];
+        } else {
+            for (std::uint16_t low : b.values) result.bits[low >> 6] &= ~(std::uint64_t(1) << (low & 63));
+        }
+        result.normalize();
+        return result;
+    }
+    // Complexity: O(1024 + arrays)
+
+public:
+    // Every value in [0, end), as full bitmaps; the universe NOT is taken against
+    static RoaringBitmap range(std::uint32_t end) {
+        RoaringBitmap result;
+        for (std::uint32_t high = 0; std::uint64_t(high) << 16 < end; ++high) {
+            std::uint32_t count = std::min<std::uint32_t>(end - (high << 16), 1u << 16);
+            Container container;
+            container.bits.assign(BITMAP_WORDS, 0);
+            for (std::uint32_t word = 0; word < count / 64; ++word) container.bits[word] = ~std::uint64_t(0);
+            if (count % 64) container.bits[count / 64] = (std::uint64_t(1) << (count % 64)) - 1;
+            container.normalize();
+            result.keys.push_back(static_cast<std::uint16_t>(high));
+            result.containers.push_back(std::move(container));
+        }
+        return result;
+    }
+    // Complexity: O(end / 64)
+
+    // Adding values in increasing order (as when indexing items one by one) appends without searching
+    void add(std::uint32_t value) {
+        auto high = static_cast<std::uint16_t>(value >> 16);
+        auto low = static_cast<std::uint16_t>(value & 0xFFFF);
+        if (keys.empty() || keys.back() < high) {
+            keys.push_back(high);
+            containers.emplace_back();
+        } else if (keys.back() != high) {
+            auto it = std::lower_bound(keys.begin(), keys.end(), high);
+            auto index = it - keys.begin();
+            if (it == keys.end() || *it != high) {
+                keys.insert(it, high);
+                containers.insert(containers.begin() + index, Container());
+            }
+            containers[static_cast<std::size_t>(index)].add(low);
+            return;
+        }
+
+        Container& last = containers.back();
+        if (!last.isBitmap() && (last.values.empty() || last.values.back() < low)) {
+            last.values.push_back(low);
+            if (++last.cardinality > ARRAY_LIMIT) last.toBitmap();
+        } else {
+            last.add(low);
+        }
+    }
+    // Complexity: O(1) amortized in increasing order, O(log containers + ARRAY_LIMIT) otherwise
+
+    bool contains(std::uint32_t value) const {
+        auto high = static_cast<std::uint16_t>(value >> 16);
+        auto it = std::lower_bound(keys.begin(), keys.end(), high);
+        return it != keys.end() && *it == high &&
+               containers[static_cast<std::size_t>(it - keys.begin())].contains(static_cast<std::uint16_t>(value & 0xFFFF));
+    }
+    // Complexity: O(log containers + log ARRAY_LIMIT)
+
+    std::size_t cardinality() const {
+        std::size_t total = 0;
+        for (const Container& container : containers) total += container.cardinality;
+        return total;
+    }
+
+    bool isEmpty() const { return containers.empty(); }
+
+    // Heap bytes held by the containers
+    std::size_t memoryBytes() const {
+        std::size_t total = keys.capacity() * sizeof(std::uint16_t) + containers.capacity() * sizeof(Container);
+        for (const Container& container : containers) {
+            total += container.values.capacity() * sizeof(std::uint16_t) + container.bits.capacity() * sizeof(std::uint64_t);
+        }
+        return total;
+    }
+
+    // Call visit(value) for every value in increasing order
+    template <typename Visit>
+    void forEach(Visit&& visit) const {
+        forEachWhile([&](std::uint32_t value) {
+            visit(value);
+            return true;
+        });
+    }
+
+    // Call visit(value) in increasing order until it returns false; returns whether every value was visited
+    template <typename Visit>
+    bool forEachWhile(Visit&& visit) const {
+        for (std::size_t index = 0; index < keys.size(); ++index) {
+            std::uint32_t base = std::uint32_t(keys[index]) << 16;
+            const Container& container = containers[index];
+            if (!container.isBitmap()) {
+                for (std::uint16_t low : container.values) {
+                    if (!visit(base | low)) return false;
+                }
+                continue;
+            }
+            for (std::size_t word = 0; word < BITMAP_WORDS; ++word) {
+                for (std::uint64_t rest = container.bits[word]; rest; rest &= rest - 1) {
+                    if (!visit(base | static_cast<std::uint32_t>(word * 64 + std::countr_zero(rest)))) return false;
+                }
+            }
+        }
+        return true;
+    }
+    // Complexity: O(values visited), plus O(1024) per bitmap container reached
+
+    std::vector<std::uint32_t> toVector() const {
+        std::vector<std::uint32_t> values;
+        values.reserve(cardinality());
+        forEach([&](std::uint32_t value) { values.push_back(value); });
+        return values;
+    }
+
+    friend RoaringBitmap operator&(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        std::size_t i = 0, j = 0;
+        while (i < a.keys.size() && j < b.keys.size()) {
+            if (a.keys[i] < b.keys[j]) {
+                ++i;
+            } else if (b.keys[j] < a.keys[i]) {
+                ++j;
+            } else {
+                Container both = intersect(a.containers[i], b.containers[j]);
+                if (both.cardinality) {
+                    result.keys.push_back(a.keys[i]);
+                    result.containers.push_back(std::move(both));
+                }
+                ++i;
+                ++j;
+            }
+        }
+        return result;
+    }
+    // Complexity: O(containers of the smaller side, times container work)
+
+    friend RoaringBitmap operator|(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        std::size_t i = 0, j = 0;
+        while (i < a.keys.size() || j < b.keys.size()) {
+            if (j == b.keys.size() || (i < a.keys.size() && a.keys[i] < b.keys[j])) {
+                result.keys.push_back(a.keys[i]);
+                result.containers.push_back(a.containers[i++]);
+            } else if (i == a.keys.size() || b.keys[j] < a.keys[i]) {
+                result.keys.push_back(b.keys[j]);
+                result.containers.push_back(b.containers[j++]);
+            } else {
+                result.keys.push_back(a.keys[i]);
+                result.containers.push_back(unite(a.containers[i++], b.containers[j++]));
+            }
+        }
+        return result;
+    }
+    // Complexity: O(containers on both sides, times container work)
+
+    // Values of a that are not in b
+    friend RoaringBitmap operator-(const RoaringBitmap& a, const RoaringBitmap& b) {
+        RoaringBitmap result;
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < a.keys.size(); ++i) {
+            while (j < b.keys.size() && b.keys[j] < a.keys[i]) ++j;
+            if (j == b.keys.size() || b.keys[j] != a.keys[i]) {
+                result.keys.push_back(a.keys[i]);
+                result.containers.push_back(a.containers[i]);
+                continue;
+            }
+            Container rest = subtract(a.containers[i], b.containers[j]);
+            if (rest.cardinality) {
+                result.keys.push_back(a.keys[i]);
+                result.containers.push_back(std::move(rest));
+            }
+        }
+        return result;
+    }
+    // Complexity: O(containers on both sides, times container work)
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_ROARINGBITMAP_H
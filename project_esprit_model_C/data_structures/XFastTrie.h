@@ -103,6 +103,8 @@ void XFastTrie<Key, Value>::insert(Key key, const Value& value) {
 
 template<typename Key, typename Value>
 void XFastTrie<Key, Value>::remove(Key key) {
+    Node* path[BITS + 1];
+    path[0] = root;
     Node* currentNode = root;
 
     for (int i = BITS - 1; i >= 0; --i) {
@@ -122,6 +124,7 @@ void XFastTrie<Key, Value>::remove(Key key) {
             }
         }
 
+        path[BITS - i] = currentNode;
         levelHashTables[i].remove(key); // Remove key from hash table
     }
 
@@ -131,6 +134,16 @@ void XFastTrie<Key, Value>::remove(Key key) {
         delete currentNode->leaf;
         currentNode->leaf = nullptr;
     }
+
+    // Prune the branch that no longer leads to any leaf, so every remaining node has a leaf below it
+    for (int depth = BITS; depth > 0; --depth) {
+        Node* node = path[depth];
+        if (node->leaf || node->left || node->right) break;
+
+        Node* parent = path[depth - 1];
+        (parent->left == node ? parent->left : parent->right) = nullptr;
+        delete node;
+    }
 }
 
 // Find a key in the trie
@@ -161,44 +174,51 @@ typename XFastTrie<Key, Value>::Leaf* XFastTrie<Key, Value>::find(Key key) {
 
 // Complexity: O(log U). Traverses the trie once, checking each bit of the key.
 
-// Find the predecessor of a key
+// Find the predecessor of a key (largest key strictly smaller than `key`)
 template <typename Key, typename Value>
 typename XFastTrie<Key, Value>::Leaf* XFastTrie<Key, Value>::pred(Key key) {
-    Key prefix = key >> 1;  // Start with the most significant bit
-    for (int i = BITS - 1; i >= 0; --i) {
-        if (levelHashTables[i].contains(prefix)) {
-            Node* predecessorNode = levelHashTables[i].get(prefix);
-            while (predecessorNode->right) {
-                predecessorNode = predecessorNode->right;  // Go right to find predecessor
-            }
-            return predecessorNode->leaf;
+    Node* currentNode = root;
+    Node* candidate = nullptr;  // Deepest left sibling of the search path
+
+    for (int i = BITS - 1; i >= 0 && currentNode; --i) {
+        if (getBit(key, i)) {
+            if (currentNode->left) candidate = currentNode->left;
+            currentNode = currentNode->right;
+        } else {
+            currentNode = currentNode->left;
         }
-        prefix >>= 1;  // Move to a shorter prefix
     }
-    return nullptr;
+
+    if (!candidate) return nullptr;
+    while (!candidate->leaf) {
+        candidate = candidate->right ? candidate->right : candidate->left;  // Rightmost leaf of the subtree
+    }
+    return candidate->leaf;
 }
-// Complexity: O(log U). Traverses up to log U levels of the trie, performing O(1) operations per level.
+// Complexity: O(log U). One descent along the key's bits and one descent to the rightmost leaf.
 
-// Find the successor of a key
+// Find the successor of a key (smallest key strictly greater than `key`)
 template <typename Key, typename Value>
 typename XFastTrie<Key, Value>::Leaf* XFastTrie<Key, Value>::succ(Key key) {
-    Leaf* target = find(key);
-
-    if (target != nullptr) {
-        auto it = leafList.begin();
+    Node* currentNode = root;
+    Node* candidate = nullptr;  // Deepest right sibling of the search path
 
-        while (it != leafList.end()) {
-            if ((*it)->key == key) {
-                ++it;
-                return it != leafList.end() ? *it : nullptr;
-            }
-            ++it;
+    for (int i = BITS - 1; i >= 0 && currentNode; --i) {
+        if (getBit(key, i)) {
+            currentNode = currentNode->right;
+        } else {
+            if (currentNode->right) candidate = currentNode->right;
+            currentNode = currentNode->left;
         }
     }
 
-    return nullptr;
+    if (!candidate) return nullptr;
+    while (!candidate->leaf) {
+        candidate = candidate->left ? candidate->left : candidate->right;  // Leftmost leaf of the subtree
+    }
+    return candidate->leaf;
 }
-// Complexity: O(log U) for finding the key and O(1) for finding the next element in the leaf list.
+// Complexity: O(log U). One descent along the key's bits and one descent to the leftmost leaf.
 
 
 // Display the trie structure
@@ -5,7 +5,11 @@
 #ifndef PROJECT_ESPRIT_MODEL_C_YFASTTRIE_H
 #define PROJECT_ESPRIT_MODEL_C_YFASTTRIE_H
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
 #include "XFastTrie.h"
 #include "AVL.h"
 
@@ -17,23 +21,28 @@ private:
 
     // Helper to find the cluster for a key
     AVL<Key, Value>* findCluster(Key key) {
+        auto exactNode = globalStructure.find(key); // `key` is itself a representative
+        if (exactNode) {
+            return exactNode->value;
+        }
+
         auto predNode = globalStructure.pred(key);
         if (predNode) {
-            std::cout << "Predecessor cluster found for key: " << key << ", Representative: " << predNode->key << "\n";
             return predNode->value; // `value` is a pointer to AVL
         }
 
         auto succNode = globalStructure.succ(key);
         if (succNode) {
-            std::cout << "Successor cluster found for key: " << key << ", Representative: " << succNode->key << "\n";
             return succNode->value; // `value` is a pointer to AVL
         }
 
-        std::cout << "No cluster found for key: " << key << "\n";
         return nullptr;
     }
 
 public:
+    // Query result: the found key and a pointer to its value inside the owning cluster, or empty
+    using Entry = std::optional<std::pair<Key, Value*>>;
+
     YFastTrie() = default;
 
     ~YFastTrie() = default; // Smart pointers clean up automatically\\
@@ -44,11 +53,9 @@ public:
 
 
     void insert(Key key, Value value) {
-        std::cout << "Inserting key: " << key << " with value: " << value << "\n";
         AVL<Key, Value>* cluster = findCluster(key);
 
         if (!cluster) {
-            std::cout << "No cluster found for key: " << key << ". Creating new cluster.\n";
             auto newCluster = std::make_unique<AVL<Key, Value>>();
             newCluster->insert(key, value);
             Key representativeKey = newCluster->findMinKey();
@@ -89,39 +96,76 @@ public:
         return cluster ? cluster->search(key) : nullptr;
     }
 
-    std::pair<Key, Value> predecessor(Key key) {
+    Entry predecessor(Key key) {
         AVL<Key, Value>* cluster = findCluster(key);
         if (cluster) {
             auto predNode = cluster->pred(key);
             if (predNode) {
-                return {predNode->key, predNode->value};
+                return std::pair<Key, Value*>(predNode->key, &predNode->value);
             }
         }
 
         auto globalPred = globalStructure.pred(key);
         if (globalPred && globalPred->value) {
             auto clusterPred = globalPred->value->findMax();
-            return {clusterPred->key, clusterPred->value};
+            return std::pair<Key, Value*>(clusterPred->key, &clusterPred->value);
         }
 
-        return {Key(), Value()}; // No predecessor
+        return std::nullopt; // No predecessor
     }
 
-    std::pair<Key, Value> successor(Key key) {
+    Entry successor(Key key) {
         AVL<Key, Value>* cluster = findCluster(key);
         if (cluster) {
             auto succNode = cluster->succ(key);
-            if (succNode) return {succNode->key, succNode->value};
+            if (succNode) return std::pair<Key, Value*>(succNode->key, &succNode->value);
         }
 
         auto globalSucc = globalStructure.succ(key);
         if (globalSucc && globalSucc->value) {
             auto clusterSucc = globalSucc->value->findMin();
-            return {clusterSucc->key, clusterSucc->value};
+            return std::pair<Key, Value*>(clusterSucc->key, &clusterSucc->value);
+        }
+
+        return std::nullopt; // No successor
+    }
+
+    // Batched predecessor queries, answered in probe order.
+    // Probes are visited in sorted order so consecutive probes falling inside the same cluster are
+    // answered from that cluster directly, skipping the X-Fast Trie lookup.
+    std::vector<Entry> predecessor_many(std::span<const Key> keys) {
+        std::vector<Entry> results(keys.size());
+        std::vector<std::size_t> order(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+
+        AVL<Key, Value>* cluster = nullptr;
+        Key low = Key();
+        Key high = Key();
+
+        for (std::size_t index : order) {
+            Key key = keys[index];
+
+            // Clusters cover disjoint key ranges, so a probe in (low, high] has its predecessor here
+            if (cluster && low < key && key <= high) {
+                auto predNode = cluster->pred(key);
+                results[index] = std::pair<Key, Value*>(predNode->key, &predNode->value);
+                continue;
+            }
+
+            results[index] = predecessor(key);
+            cluster = findCluster(key);
+            if (cluster && !cluster->isEmpty()) {
+                low = cluster->findMinKey();
+                high = cluster->findMaxKey();
+            } else {
+                cluster = nullptr;
+            }
         }
 
-        return {Key(), Value()}; // No successor
+        return results;
     }
+    // Complexity: O(m log m) for sorting plus O(log n) per probe; probes sharing a cluster skip the global lookup
 
     void display() const {
         std::cout << "Y-Fast Trie Contents:\n";
@@ -0,0 +1,271 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_YFASTTRIESNAPSHOT_H
+#define PROJECT_ESPRIT_MODEL_C_YFASTTRIESNAPSHOT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Read-optimized, versioned Y-Fast Trie.
+// Keys live in sorted clusters of Theta(log U) entries indexed by their representative (minimum) key.
+// A published version is never modified: writers copy only the clusters they touch plus the
+// representative index, then publish the new version with a single atomic store. Readers pin a
+// version through a Snapshot and query it without ever waiting on the writer mutex; a retired version
+// (and every cluster only it referenced) is reclaimed when the last snapshot pinning it is dropped.
+// Query results point into the pinned version and stay valid for as long as the Snapshot lives.
+template <typename Key, typename Value>
+class ConcurrentYFastTrie {
+private:
+    static constexpr std::size_t CLUSTER_CAPACITY = sizeof(Key) * 8 * 2; // Split threshold, 2 log U
+    static constexpr std::size_t CLUSTER_MERGE = CLUSTER_CAPACITY / 4;   // Merge threshold
+
+    struct Cluster {
+        std::vector<Key> keys;     // Sorted, unique
+        std::vector<Value> values; // Parallel to keys
+    };
+
+    struct Version {
+        std::uint64_t epoch = 0;
+        std::size_t size = 0;
+        std::vector<Key> representatives;                // Minimum key of each cluster, sorted
+        std::vector<std::shared_ptr<Cluster>> clusters;  // Parallel to representatives
+    };
+
+    using VersionPtr = std::shared_ptr<const Version>;
+
+    std::atomic<VersionPtr> current;
+    std::mutex writerMutex; // Serializes writers only
+
+    // Writer-side working copy of a version. Clusters are shared with the published version until
+    // the first write touches them.
+    struct Builder {
+        Version next;
+        std::unordered_set<const Cluster*> owned; // Clusters copied during this update
+
+        explicit Builder(const Version& base) : next(base) {
+            next.epoch = base.epoch + 1;
+        }
+
+        Cluster& mutableCluster(std::size_t index) {
+            auto& cluster = next.clusters[index];
+            if (!owned.contains(cluster.get())) {
+                cluster = std::make_shared<Cluster>(*cluster);
+                owned.insert(cluster.get());
+            }
+            return *cluster;
+        }
+
+        // Index of the cluster that should hold `key` (the last one whose representative is <= key)
+        std::size_t clusterFor(Key key) const {
+            auto it = std::upper_bound(next.representatives.begin(), next.representatives.end(), key);
+            return it == next.representatives.begin() ? 0 : static_cast<std::size_t>(it - next.representatives.begin()) - 1;
+        }
+
+        void insert(Key key, const Value& value) {
+            if (next.clusters.empty()) {
+                auto cluster = std::make_shared<Cluster>();
+                cluster->keys.push_back(key);
+                cluster->values.push_back(value);
+                owned.insert(cluster.get());
+                next.representatives.push_back(key);
+                next.clusters.push_back(std::move(cluster));
+                next.size = 1;
+                return;
+            }
+
+            std::size_t index = clusterFor(key);
+            Cluster& cluster = mutableCluster(index);
+            auto pos = std::lower_bound(cluster.keys.begin(), cluster.keys.end(), key);
+            auto offset = pos - cluster.keys.begin();
+
+            if (pos != cluster.keys.end() && *pos == key) {
+                cluster.values[offset] = value; // Update value if key already exists
+                return;
+            }
+
+            cluster.keys.insert(pos, key);
+            cluster.values.insert(cluster.values.begin() + offset, value);
+            next.representatives[index] = cluster.keys.front();
+            ++next.size;
+
+            if (cluster.keys.size() > CLUSTER_CAPACITY) {
+                split(index);
+            }
+        }
+
+        void remove(Key key) {
+            if (next.clusters.empty()) return;
+
+            std::size_t index = clusterFor(key);
+            const Cluster& shared = *next.clusters[index];
+            if (!std::binary_search(shared.keys.begin(), shared.keys.end(), key)) return;
+
+            Cluster& cluster = mutableCluster(index);
+            auto pos = std::lower_bound(cluster.keys.begin(), cluster.keys.end(), key);
+            auto offset = pos - cluster.keys.begin();
+            cluster.keys.erase(pos);
+            cluster.values.erase(cluster.values.begin() + offset);
+            --next.size;
+
+            if (cluster.keys.empty()) {
+                next.representatives.erase(next.representatives.begin() + static_cast<std::ptrdiff_t>(index));
+                next.clusters.erase(next.clusters.begin() + static_cast<std::ptrdiff_t>(index));
+                return;
+            }
+
+            next.representatives[index] = cluster.keys.front();
+            if (cluster.keys.size() < CLUSTER_MERGE && next.clusters.size() > 1) {
+                merge(index + 1 < next.clusters.size() ? index : index - 1);
+            }
+        }
+
+        // Split an oversized cluster into two halves
+        void split(std::size_t index) {
+            Cluster& cluster = mutableCluster(index);
+            auto half = static_cast<std::ptrdiff_t>(cluster.keys.size() / 2);
+
+            auto upper = std::make_shared<Cluster>();
+            upper->keys.assign(cluster.keys.begin() + half, cluster.keys.end());
+            upper->values.assign(cluster.values.begin() + half, cluster.values.end());
+            cluster.keys.resize(static_cast<std::size_t>(half));
+            cluster.values.resize(static_cast<std::size_t>(half));
+            owned.insert(upper.get());
+
+            auto at = static_cast<std::ptrdiff_t>(index) + 1;
+            next.representatives.insert(next.representatives.begin() + at, upper->keys.front());
+            next.clusters.insert(next.clusters.begin() + at, std::move(upper));
+        }
+
+        // Merge cluster `index + 1` into cluster `index`, re-splitting if the result is oversized
+        void merge(std::size_t index) {
+            Cluster& left = mutableCluster(index);
+            const Cluster& right = *next.clusters[index + 1];
+            left.keys.insert(left.keys.end(), right.keys.begin(), right.keys.end());
+            left.values.insert(left.values.end(), right.values.begin(), right.values.end());
+
+            auto at = static_cast<std::ptrdiff_t>(index) + 1;
+            next.representatives.erase(next.representatives.begin() + at);
+            next.clusters.erase(next.clusters.begin() + at);
+
+            if (left.keys.size() > CLUSTER_CAPACITY) {
+                split(index);
+            }
+        }
+    };
+
+    // Run `update` on a writer-side copy of the current version and publish the result
+    template <typename Update>
+    void publish(Update&& update) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        VersionPtr base = current.load(std::memory_order_acquire);
+        Builder builder(*base);
+        update(builder);
+        current.store(std::make_shared<const Version>(std::move(builder.next)), std::memory_order_release);
+    }
+
+public:
+    // Immutable, consistent view of one published version
+    class Snapshot {
+    private:
+        VersionPtr version;
+
+        // Index of the last cluster whose representative is <= key, or -1 if none
+        std::ptrdiff_t clusterAtOrBelow(Key key) const {
+            const auto& reps = version->representatives;
+            return (std::upper_bound(reps.begin(), reps.end(), key) - reps.begin()) - 1;
+        }
+
+    public:
+        explicit Snapshot(VersionPtr version) : version(std::move(version)) {}
+
+        std::uint64_t epoch() const { return version->epoch; }
+        std::size_t size() const { return version->size; }
+        bool isEmpty() const { return version->size == 0; }
+
+        const Value* search(Key key) const {
+            std::ptrdiff_t index = clusterAtOrBelow(key);
+            if (index < 0) return nullptr;
+
+            const Cluster& cluster = *version->clusters[index];
+            auto pos = std::lower_bound(cluster.keys.begin(), cluster.keys.end(), key);
+            if (pos == cluster.keys.end() || *pos != key) return nullptr;
+            return &cluster.values[pos - cluster.keys.begin()];
+        }
+        // Complexity: O(log n)
+
+        // Largest key strictly smaller than `key`
+        std::optional<std::pair<Key, const Value*>> predecessor(Key key) const {
+            const auto& reps = version->representatives;
+            std::ptrdiff_t index = (std::lower_bound(reps.begin(), reps.end(), key) - reps.begin()) - 1;
+            if (index < 0) return std::nullopt;
+
+            const Cluster& cluster = *version->clusters[index];
+            auto pos = std::lower_bound(cluster.keys.begin(), cluster.keys.end(), key) - 1;
+            auto offset = pos - cluster.keys.begin();
+            return std::pair<Key, const Value*>(*pos, &cluster.values[offset]);
+        }
+        // Complexity: O(log n)
+
+        // Smallest key strictly greater than `key`
+        std::optional<std::pair<Key, const Value*>> successor(Key key) const {
+            const auto& clusters = version->clusters;
+            std::ptrdiff_t index = clusterAtOrBelow(key);
+
+            if (index >= 0) {
+                const Cluster& cluster = *clusters[index];
+                auto pos = std::upper_bound(cluster.keys.begin(), cluster.keys.end(), key);
+                if (pos != cluster.keys.end()) {
+                    return std::pair<Key, const Value*>(*pos, &cluster.values[pos - cluster.keys.begin()]);
+                }
+            }
+
+            auto nextIndex = static_cast<std::size_t>(index + 1);
+            if (nextIndex >= clusters.size()) return std::nullopt;
+            return std::pair<Key, const Value*>(clusters[nextIndex]->keys.front(), &clusters[nextIndex]->values.front());
+        }
+        // Complexity: O(log n)
+    };
+
+    ConcurrentYFastTrie() : current(std::make_shared<const Version>()) {}
+
+    ConcurrentYFastTrie(const ConcurrentYFastTrie&) = delete;
+    ConcurrentYFastTrie& operator=(const ConcurrentYFastTrie&) = delete;
+
+    // Pin the latest published version. Never blocks on writers.
+    Snapshot snapshot() const {
+        return Snapshot(current.load(std::memory_order_acquire));
+    }
+
+    void insert(Key key, const Value& value) {
+        publish([&](Builder& builder) { builder.insert(key, value); });
+    }
+    // Complexity: O(log U + n / log U) pointer copies for the new representative index
+
+    void remove(Key key) {
+        publish([&](Builder& builder) { builder.remove(key); });
+    }
+
+    // Apply many inserts and publish them as a single version
+    void insertBatch(const std::vector<std::pair<Key, Value>>& entries) {
+        publish([&](Builder& builder) {
+            for (const auto& [key, value] : entries) {
+                builder.insert(key, value);
+            }
+        });
+    }
+
+    std::size_t size() const {
+        return snapshot().size();
+    }
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_YFASTTRIESNAPSHOT_H
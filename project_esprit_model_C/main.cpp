@@ -9,6 +9,8 @@
 #include "scripts/Helper.h"
 #include "core/Config/Config.h"
 #include "scripts/TestUnit.h"
+#include "scripts/BenchUnit.h"
+#include "scripts/ItemLoader.h"
 
 // --- Window and Console specifications (Config initialization) ---
 
@@ -62,12 +64,22 @@ int main(){
         console_system.setFillColor(sf::Color::Yellow);
         console_system.setPosition(static_cast<float>(consoleConfiguration.RELATIVE_RIGHT_X_EDGE), static_cast<float>(consoleConfiguration.RELATIVE_UPPER_Y_EDGE));
 
+    // Item catalog and its tag index, queried by /tags
+    ItemStore items;
+    try {
+        loadItems("sources/items.txt", items);
+    } catch (const std::runtime_error& error) {
+        std::cerr << "Failed to load items: " << error.what() << std::endl;
+    }
+    TagIndex tagIndex(items);
+
     // Create the commands
     ClearConsoleCommand clearCommand;
     HelpCommand helpCommand;
     RunCppFileCommand runCommand;
     SetStringVarCommand setCommand(local_variables);
     CloseWindowCommand closeCommand(window);
+    TagQueryCommand tagsCommand(items, tagIndex);
 
     // Add commands to the map
     std::unordered_map<std::string, Command*> commandMap;
@@ -76,6 +88,7 @@ int main(){
     commandMap[runCommand.getPrefix()] = &runCommand;
     commandMap[setCommand.getPrefix()] = &setCommand;
     commandMap[closeCommand.getPrefix()] = &closeCommand;
+    commandMap[tagsCommand.getPrefix()] = &tagsCommand;
 
     std::ostringstream systemStream;
     sf::Clock frameClock;
@@ -86,6 +99,7 @@ int main(){
     helpCommand.addCommand(&runCommand);
     helpCommand.addCommand(&setCommand);
     helpCommand.addCommand(&closeCommand);
+    helpCommand.addCommand(&tagsCommand);
 
     consoleLines.emplace_back("Welcome to the SFML console!");
 
@@ -0,0 +1,108 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#include "BatchPathfinder.h"
+#include <algorithm>
+
+BatchPathfinder::BatchPathfinder(const GridMap& map, unsigned threads) {
+    unsigned count = std::max(1u, threads);
+    workers.reserve(count);
+    for (unsigned i = 0; i < count; ++i) workers.emplace_back(map);
+
+    this->threads.reserve(count - 1);
+    for (unsigned i = 1; i < count; ++i) this->threads.emplace_back(&BatchPathfinder::threadLoop, this, i);
+}
+
+BatchPathfinder::~BatchPathfinder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) thread.join();
+}
+
+void BatchPathfinder::threadLoop(std::size_t worker) {
+    std::size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        work(workers[worker]);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) done.notify_one();
+    }
+}
+
+// Claim chunks of requests until none are left. Costs go straight to the shared result (each index
+// is written by exactly one worker); cells stay in the worker's own buffer until the batch ends.
+void BatchPathfinder::work(Worker& worker) {
+    worker.cells.clear();
+    worker.spans.clear();
+
+    try {
+        while (true) {
+            std::size_t first = next.fetch_add(CHUNK, std::memory_order_relaxed);
+            if (first >= batch.size()) break;
+
+            std::size_t last = std::min(first + CHUNK, batch.size());
+            for (std::size_t request = first; request < last; ++request) {
+                const PathRequest& query = batch[request];
+                (*batchCosts)[request] = worker.pathfinder.findPath(query.start, query.goal, batchAlgorithm, worker.scratch);
+                worker.spans.push_back({request, worker.cells.size(), worker.scratch.size()});
+                worker.cells.insert(worker.cells.end(), worker.scratch.begin(), worker.scratch.end());
+            }
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failure) failure = std::current_exception();
+        next.store(batch.size(), std::memory_order_relaxed); // Stop handing out requests
+    }
+}
+
+void BatchPathfinder::findPaths(std::span<const PathRequest> requests, Pathfinder::Algorithm algorithm, PathBatch& results) {
+    results.costs.assign(requests.size(), Pathfinder::NO_PATH);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch = requests;
+        batchAlgorithm = algorithm;
+        batchCosts = &results.costs;
+        next.store(0, std::memory_order_relaxed);
+        failure = nullptr;
+        busy = static_cast<unsigned>(threads.size());
+        ++generation;
+    }
+    wake.notify_all();
+
+    work(workers[0]);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return busy == 0; });
+    }
+    if (failure) std::rethrow_exception(failure);
+
+    // Gather: lengths first, then one prefix sum, then every worker's paths copied into place
+    results.offsets.assign(requests.size() + 1, 0);
+    for (const auto& worker : workers) {
+        for (const Span& span : worker.spans) results.offsets[span.request + 1] = span.length;
+    }
+    for (std::size_t request = 0; request < requests.size(); ++request) {
+        results.offsets[request + 1] += results.offsets[request];
+    }
+
+    results.cells.resize(results.offsets.back());
+    for (const auto& worker : workers) {
+        for (const Span& span : worker.spans) {
+            std::copy_n(worker.cells.begin() + static_cast<std::ptrdiff_t>(span.offset), span.length,
+                        results.cells.begin() + static_cast<std::ptrdiff_t>(results.offsets[span.request]));
+        }
+    }
+}
+// Complexity: O(total search work / threads + total path length)
@@ -0,0 +1,96 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_BATCHPATHFINDER_H
+#define PROJECT_ESPRIT_MODEL_C_BATCHPATHFINDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+#include "Pathfinder.h"
+
+struct PathRequest {
+    Cell start;
+    Cell goal;
+};
+
+// Results of one batch, stored back to back: path i is cells[offsets[i], offsets[i + 1]) and
+// costs[i] is its total cost (Pathfinder::NO_PATH with an empty span when unreachable)
+struct PathBatch {
+    std::vector<Cell> cells;
+    std::vector<std::size_t> offsets;
+    std::vector<int> costs;
+
+    std::size_t size() const { return costs.size(); }
+
+    std::span<const Cell> path(std::size_t request) const {
+        return std::span<const Cell>(cells).subspan(offsets[request], offsets[request + 1] - offsets[request]);
+    }
+};
+
+// Runs many path queries over one GridMap on a persistent pool of threads, e.g. every NPC that asks
+// for a route in the same tick. Each worker owns a Pathfinder, so its search buffers are allocated
+// once and reused by every request it takes; requests are handed out in small chunks through an
+// atomic counter so long and short searches balance out. The calling thread works as worker 0.
+// The map must not change while a batch runs, and one BatchPathfinder runs one batch at a time.
+class BatchPathfinder {
+public:
+    explicit BatchPathfinder(const GridMap& map, unsigned threads = std::thread::hardware_concurrency());
+    ~BatchPathfinder();
+
+    BatchPathfinder(const BatchPathfinder&) = delete;
+    BatchPathfinder& operator=(const BatchPathfinder&) = delete;
+
+    // Solve every request and replace the contents of `results` (whose buffers are reused).
+    // If a search throws, the batch still finishes and the first exception is rethrown.
+    void findPaths(std::span<const PathRequest> requests, Pathfinder::Algorithm algorithm, PathBatch& results);
+
+    unsigned threadCount() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    static constexpr std::size_t CHUNK = 4; // Requests claimed per visit to the shared counter
+
+    // Where one path landed in its worker's buffer
+    struct Span {
+        std::size_t request;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    // Aligned so the hot fields of neighbouring workers never share a cache line
+    struct alignas(64) Worker {
+        Pathfinder pathfinder;
+        std::vector<Cell> cells;  // Paths found by this worker in the current batch
+        std::vector<Span> spans;
+        std::vector<Cell> scratch;
+
+        explicit Worker(const GridMap& map) : pathfinder(map) {}
+    };
+
+    std::vector<Worker> workers;
+    std::vector<std::thread> threads; // workers[i + 1] runs on threads[i]
+
+    // Current batch, published under `mutex` by bumping `generation`
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::size_t generation = 0;
+    unsigned busy = 0;
+    bool stopping = false;
+    std::span<const PathRequest> batch;
+    Pathfinder::Algorithm batchAlgorithm = Pathfinder::Algorithm::AStar;
+    std::vector<int>* batchCosts = nullptr;
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr failure;
+
+    void threadLoop(std::size_t worker);
+    void work(Worker& worker);
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_BATCHPATHFINDER_H
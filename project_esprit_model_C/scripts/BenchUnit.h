@@ -0,0 +1,1050 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_BENCHUNIT_H
+#define PROJECT_ESPRIT_MODEL_C_BENCHUNIT_H
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <thread>
+#include "../data_structures/YFastTrie.h"
+#include "../data_structures/HierarchicalBitset.h"
+#include "../data_structures/BPlusTree.h"
+#include "../data_structures/OrderedIndex.h"
+#include "../data_structures/AVL.h"
+#include "../data_structures/CompactAVL.h"
+#include "../data_structures/PriorityQueue.h"
+#include "../data_structures/BucketQueue.h"
+#include "Pathfinder.h"
+#include "HierarchicalPathfinder.h"
+#include "BatchPathfinder.h"
+#include "FlowField.h"
+#include "ItemStore.h"
+#include "ItemLoader.h"
+#include "ItemCatalog.h"
+#include "TagIndex.h"
+#include "Helper.h"
+#include <filesystem>
+#include <fstream>
+
+// Benchmark functions. Each one prints nanoseconds per operation for a fixed seed.
+
+// Run `body` once and return the elapsed time in nanoseconds divided by `operations`
+template <typename Body>
+double nanosPerOp(std::size_t operations, Body&& body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(operations);
+}
+
+void BenchHierarchicalBitset() {
+    std::cout << "Benchmarking HierarchicalBitset<16> against YFastTrie...\n";
+
+    constexpr std::uint32_t UNIVERSE = 1u << 16;
+    constexpr std::size_t PROBES = 100000;
+
+    for (double density : {0.01, 0.10, 0.50}) {
+        std::mt19937 rng(42);
+        std::vector<std::uint32_t> keys(UNIVERSE);
+        for (std::uint32_t i = 0; i < UNIVERSE; ++i) keys[i] = i;
+        std::shuffle(keys.begin(), keys.end(), rng);
+        keys.resize(static_cast<std::size_t>(UNIVERSE * density));
+
+        std::vector<std::uint32_t> probes(PROBES);
+        for (auto& probe : probes) probe = rng() % UNIVERSE;
+
+        HierarchicalBitset<16> bitset;
+        YFastTrie<int, int> yFastTrie;
+        std::uint64_t checksum = 0;
+
+        double bitsetInsert = nanosPerOp(keys.size(), [&]() {
+            for (auto key : keys) bitset.insert(key);
+        });
+        double trieInsert = nanosPerOp(keys.size(), [&]() {
+            for (auto key : keys) yFastTrie.insert(static_cast<int>(key), static_cast<int>(key));
+        });
+
+        double bitsetSucc = nanosPerOp(PROBES, [&]() {
+            for (auto probe : probes) {
+                auto succ = bitset.succ(probe);
+                checksum += succ ? *succ : 0;
+            }
+        });
+        double trieSucc = nanosPerOp(PROBES, [&]() {
+            for (auto probe : probes) {
+                auto succ = yFastTrie.successor(static_cast<int>(probe));
+                checksum += succ ? static_cast<std::uint64_t>(succ->first) : 0;
+            }
+        });
+
+        double bitsetPred = nanosPerOp(PROBES, [&]() {
+            for (auto probe : probes) {
+                auto pred = bitset.pred(probe);
+                checksum += pred ? *pred : 0;
+            }
+        });
+        double triePred = nanosPerOp(PROBES, [&]() {
+            for (auto probe : probes) {
+                auto pred = yFastTrie.predecessor(static_cast<int>(probe));
+                checksum += pred ? static_cast<std::uint64_t>(pred->first) : 0;
+            }
+        });
+
+        std::cout << "Density " << density * 100 << "% (" << keys.size() << " keys)\n"
+                  << "  insert: bitset " << bitsetInsert << " ns/op, YFastTrie " << trieInsert << " ns/op\n"
+                  << "  succ:   bitset " << bitsetSucc << " ns/op, YFastTrie " << trieSucc << " ns/op\n"
+                  << "  pred:   bitset " << bitsetPred << " ns/op, YFastTrie " << triePred << " ns/op\n"
+                  << "  (checksum " << checksum << ")\n";
+    }
+
+    std::cout << "HierarchicalBitset benchmark completed.\n";
+}
+
+// Insert, search and successor timings for one OrderedIndex backend
+template <typename Index>
+void benchOrderedIndex(const char* name, const std::vector<std::uint64_t>& keys, const std::vector<std::uint64_t>& probes) {
+    static_assert(OrderedIndex<Index, std::uint64_t, int>);
+    Index index;
+    std::uint64_t checksum = 0;
+
+    double insert = nanosPerOp(keys.size(), [&]() {
+        for (auto key : keys) index.insert(key, 1);
+    });
+    double search = nanosPerOp(probes.size(), [&]() {
+        for (auto probe : probes) checksum += index.search(probe) != nullptr;
+    });
+    double succ = nanosPerOp(probes.size(), [&]() {
+        for (auto probe : probes) {
+            auto next = index.successor(probe);
+            checksum += next ? next->first : 0;
+        }
+    });
+
+    std::cout << "  " << name << ": insert " << insert << " ns/op, search " << search
+              << " ns/op, succ " << succ << " ns/op (checksum " << checksum << ")\n";
+}
+
+void BenchBPlusTree() {
+    std::cout << "Benchmarking BPlusTree against YFastTrie on 64-bit keys...\n";
+
+    constexpr std::size_t KEYS = 20000;
+    constexpr std::size_t PROBES = 100000;
+    std::mt19937_64 rng(7);
+
+    // Key distributions: uniform sparse, dense runs around a few bases, and sequential codes
+    std::vector<std::pair<const char*, std::vector<std::uint64_t>>> workloads(3);
+    workloads[0].first = "Uniform sparse";
+    workloads[1].first = "Clustered";
+    workloads[2].first = "Sequential";
+    for (std::size_t i = 0; i < KEYS; ++i) {
+        workloads[0].second.push_back(rng());
+        workloads[1].second.push_back((rng() % 16) * (std::uint64_t(1) << 40) + rng() % 100000);
+        workloads[2].second.push_back(1000 + i);
+    }
+
+    for (const auto& [name, keys] : workloads) {
+        std::vector<std::uint64_t> probes(PROBES);
+        for (auto& probe : probes) {
+            probe = keys[rng() % keys.size()] + (rng() % 2); // Half hits, half near misses
+        }
+
+        std::cout << name << " (" << keys.size() << " keys)\n";
+        benchOrderedIndex<BPlusTree<std::uint64_t, int>>("BPlusTree", keys, probes);
+        benchOrderedIndex<YFastTrie<std::uint64_t, int>>("YFastTrie", keys, probes);
+    }
+
+    std::cout << "BPlusTree benchmark completed.\n";
+}
+
+// AVL's insert/remove/pred/succ as they were before they became iterative, kept only as BenchAVL's
+// "before" column: the same node layout and rotations, but one stack frame per level and every
+// ancestor rebalanced on the way back up
+template <typename Key, typename Value>
+class RecursiveAVLBaseline {
+private:
+    struct Node {
+        Key key;
+        Value value;
+        int height = 1;
+        Node* left = nullptr;
+        Node* right = nullptr;
+
+        Node(Key key, Value value) : key(key), value(value) {}
+    };
+
+    Node* root = nullptr;
+
+    static int height(Node* node) { return node ? node->height : 0; }
+    static void update(Node* node) { node->height = std::max(height(node->left), height(node->right)) + 1; }
+
+    static Node* rotateRight(Node* y) {
+        Node* x = y->left;
+        y->left = x->right;
+        x->right = y;
+        update(y);
+        update(x);
+        return x;
+    }
+
+    static Node* rotateLeft(Node* x) {
+        Node* y = x->right;
+        x->right = y->left;
+        y->left = x;
+        update(x);
+        update(y);
+        return y;
+    }
+
+    static Node* balance(Node* node) {
+        update(node);
+        int bf = height(node->left) - height(node->right);
+        if (bf > 1) {
+            if (height(node->left->left) < height(node->left->right)) node->left = rotateLeft(node->left);
+            return rotateRight(node);
+        }
+        if (bf < -1) {
+            if (height(node->right->right) < height(node->right->left)) node->right = rotateRight(node->right);
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    static Node* insert(Node* node, Key key, Value value) {
+        if (!node) return new Node(key, value);
+        if (key < node->key) {
+            node->left = insert(node->left, key, value);
+        } else if (key > node->key) {
+            node->right = insert(node->right, key, value);
+        } else {
+            node->value = value;
+            return node;
+        }
+        return balance(node);
+    }
+
+    static Node* removeMin(Node* node) {
+        if (!node->left) return node->right;
+        node->left = removeMin(node->left);
+        return balance(node);
+    }
+
+    static Node* remove(Node* node, Key key) {
+        if (!node) return nullptr;
+        if (key < node->key) {
+            node->left = remove(node->left, key);
+        } else if (key > node->key) {
+            node->right = remove(node->right, key);
+        } else {
+            Node* left = node->left;
+            Node* right = node->right;
+            delete node;
+            if (!right) return left;
+
+            Node* min = right;
+            while (min->left) min = min->left;
+            min->right = removeMin(right);
+            min->left = left;
+            return balance(min);
+        }
+        return balance(node);
+    }
+
+    static Node* pred(Node* node, Key key) {
+        if (!node) return nullptr;
+        if (key <= node->key) return pred(node->left, key);
+        Node* candidate = pred(node->right, key);
+        return candidate ? candidate : node;
+    }
+
+    static Node* succ(Node* node, Key key) {
+        if (!node) return nullptr;
+        if (key >= node->key) return succ(node->right, key);
+        Node* candidate = succ(node->left, key);
+        return candidate ? candidate : node;
+    }
+
+    static void destroy(Node* node) {
+        if (!node) return;
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+
+public:
+    RecursiveAVLBaseline() = default;
+    ~RecursiveAVLBaseline() { destroy(root); }
+    RecursiveAVLBaseline(const RecursiveAVLBaseline&) = delete;
+    RecursiveAVLBaseline& operator=(const RecursiveAVLBaseline&) = delete;
+
+    void insert(Key key, Value value) { root = insert(root, key, value); }
+    void remove(Key key) { root = remove(root, key); }
+    Node* pred(Key key) { return pred(root, key); }
+    Node* succ(Key key) { return succ(root, key); }
+};
+
+void BenchAVL() {
+    std::cout << "Benchmarking AVL per-operation latency...\n";
+
+    constexpr int KEYS = 1000000;
+    std::mt19937 rng(11);
+    std::vector<int> keys(KEYS);
+    for (int i = 0; i < KEYS; ++i) keys[i] = i;
+    std::vector<int> shuffled = keys;
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    std::uint64_t checksum = 0;
+
+    {
+        AVL<int, int> tree;
+        double insert = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) tree.insert(key, key);
+        });
+        double search = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) checksum += *tree.search(key);
+        });
+        double pred = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) {
+                auto node = tree.pred(key);
+                checksum += node ? node->key : 0;
+            }
+        });
+        double succ = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) {
+                auto node = tree.succ(key);
+                checksum += node ? node->key : 0;
+            }
+        });
+        double remove = nanosPerOp(KEYS / 2, [&]() {
+            for (int i = 0; i < KEYS / 2; ++i) tree.remove(shuffled[i]);
+        });
+        double teardown = nanosPerOp(KEYS / 2, [&]() {
+            AVL<int, int> discarded;
+            std::swap(discarded, tree);
+        });
+
+        std::cout << "Random keys (" << KEYS << "), iterative\n"
+                  << "  insert " << insert << " ns/op, search " << search << " ns/op\n"
+                  << "  pred " << pred << " ns/op, succ " << succ << " ns/op\n"
+                  << "  remove " << remove << " ns/op, teardown " << teardown << " ns/node\n";
+    }
+
+    {
+        RecursiveAVLBaseline<int, int> tree;
+        double insert = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) tree.insert(key, key);
+        });
+        double pred = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) {
+                auto node = tree.pred(key);
+                checksum += node ? node->key : 0;
+            }
+        });
+        double succ = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) {
+                auto node = tree.succ(key);
+                checksum += node ? node->key : 0;
+            }
+        });
+        double remove = nanosPerOp(KEYS / 2, [&]() {
+            for (int i = 0; i < KEYS / 2; ++i) tree.remove(shuffled[i]);
+        });
+
+        std::cout << "Random keys (" << KEYS << "), recursive baseline\n"
+                  << "  insert " << insert << " ns/op\n"
+                  << "  pred " << pred << " ns/op, succ " << succ << " ns/op\n"
+                  << "  remove " << remove << " ns/op\n";
+    }
+
+    {
+        CompactAVL<int, int> tree;
+        double insert = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) tree.insert(key, key);
+        });
+        double search = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) checksum += *tree.search(key);
+        });
+        double pred = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) {
+                auto entry = tree.predecessor(key);
+                checksum += entry ? entry->first : 0;
+            }
+        });
+        double remove = nanosPerOp(KEYS / 2, [&]() {
+            for (int i = 0; i < KEYS / 2; ++i) tree.remove(shuffled[i]);
+        });
+
+        std::cout << "CompactAVL random keys (" << KEYS << ", " << sizeof(CompactAVL<int, int>::Node) << "-byte nodes)\n"
+                  << "  insert " << insert << " ns/op, search " << search << " ns/op\n"
+                  << "  pred " << pred << " ns/op, remove " << remove << " ns/op\n";
+    }
+
+    {
+        AVL<int, int> tree;
+        double insert = nanosPerOp(KEYS, [&]() {
+            for (int key : keys) tree.insert(key, key);
+        });
+        double remove = nanosPerOp(KEYS, [&]() {
+            for (int key : keys) tree.remove(key);
+        });
+
+        std::vector<std::pair<int, int>> entries;
+        entries.reserve(KEYS);
+        for (int key : keys) entries.emplace_back(key, key);
+        double bulk = nanosPerOp(KEYS, [&]() {
+            tree = AVL<int, int>::fromSorted(entries);
+        });
+        double splitJoin = nanosPerOp(KEYS, [&]() {
+            for (int key : shuffled) {
+                auto [left, right] = tree.split(key);
+                tree = AVL<int, int>::join(std::move(left), std::move(right));
+            }
+        });
+        checksum += tree.findMaxKey();
+
+        std::cout << "Sorted keys (" << KEYS << "), iterative\n"
+                  << "  insert " << insert << " ns/op, remove " << remove << " ns/op\n"
+                  << "  fromSorted " << bulk << " ns/key, split + join " << splitJoin << " ns/op\n";
+    }
+
+    {
+        RecursiveAVLBaseline<int, int> tree;
+        double insert = nanosPerOp(KEYS, [&]() {
+            for (int key : keys) tree.insert(key, key);
+        });
+        double remove = nanosPerOp(KEYS, [&]() {
+            for (int key : keys) tree.remove(key);
+        });
+
+        std::cout << "Sorted keys (" << KEYS << "), recursive baseline\n"
+                  << "  insert " << insert << " ns/op, remove " << remove << " ns/op\n";
+    }
+
+    {
+        // Counting sizes refreshes every ancestor, so sorted inserts lose the early stop
+        AVL<int, int, Counted<NoAggregate<int, int>>> tree;
+        double insert = nanosPerOp(KEYS, [&]() {
+            for (int key : keys) tree.insert(key, key);
+        });
+        checksum += tree.select(KEYS / 2)->key;
+
+        std::cout << "Sorted keys with subtree sizes (" << KEYS << ")\n"
+                  << "  insert " << insert << " ns/op\n";
+    }
+
+    std::cout << "  (checksum " << checksum << ")\n";
+    std::cout << "AVL benchmark completed.\n";
+}
+
+void BenchAVLSetOperations() {
+    std::cout << "Benchmarking AVL set operations on 1M-element trees...\n";
+
+    constexpr int KEYS = 1000000;
+    std::mt19937 rng(23);
+
+    // Two random sets of 1M codes drawn from a 4M universe, so roughly a quarter of the keys overlap
+    auto randomSet = [&]() {
+        std::vector<std::pair<int, int>> entries;
+        std::vector<int> codes(KEYS);
+        for (auto& code : codes) code = static_cast<int>(rng() % (4 * KEYS));
+        std::sort(codes.begin(), codes.end());
+        codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+        for (int code : codes) entries.emplace_back(code, 1);
+        return entries;
+    };
+    auto first = randomSet();
+    auto second = randomSet();
+
+    // Scaling sweep over every fork depth up to the default (at least 3, so forking overhead shows on
+    // few cores). Freed result trees leave the heap fragmented, which slows whatever runs next, so an
+    // untimed round settles the allocator first; then depths take turns for three rounds and keep
+    // their best time.
+    int defaultDepth = AVL<int, int>::defaultParallelDepth();
+    int maxDepth = std::max(3, defaultDepth);
+    std::cout << std::thread::hardware_concurrency() << " hardware threads, default fork depth " << defaultDepth
+              << ", " << AVLForkPool::shared().threadCount() << " pool threads\n";
+
+    std::vector<std::array<double, 3>> best(maxDepth + 1, {1e300, 1e300, 1e300});
+    std::array<double, 3> warmUp{};
+    std::uint64_t checksum = 0;
+    for (int round = 0; round <= 3; ++round) {
+        for (int depth = 0; depth <= maxDepth; ++depth) {
+            auto time = [&](auto operation) {
+                auto a = AVL<int, int>::fromSorted(first);
+                auto b = AVL<int, int>::fromSorted(second);
+                AVL<int, int> result;
+                double nanos = nanosPerOp(1, [&]() {
+                    result = operation(std::move(a), std::move(b));
+                });
+                checksum += result.size();
+                return nanos / 1e6;
+            };
+
+            auto& times = round == 0 ? warmUp : best[depth];
+            times[0] = std::min(times[0], time([&](auto&& a, auto&& b) { return AVL<int, int>::setUnion(std::move(a), std::move(b), depth); }));
+            times[1] = std::min(times[1], time([&](auto&& a, auto&& b) { return AVL<int, int>::setIntersection(std::move(a), std::move(b), depth); }));
+            times[2] = std::min(times[2], time([&](auto&& a, auto&& b) { return AVL<int, int>::setDifference(std::move(a), std::move(b), depth); }));
+        }
+    }
+
+    for (int depth = 0; depth <= maxDepth; ++depth) {
+        std::cout << (depth == 0 ? "Sequential" : "Parallel (fork depth " + std::to_string(depth) + ")") << "\n"
+                  << "  union " << best[depth][0] << " ms, intersection " << best[depth][1] << " ms, difference "
+                  << best[depth][2] << " ms\n";
+    }
+    std::cout << "  (checksum " << checksum << ")\n";
+
+    std::cout << "AVL set operations benchmark completed.\n";
+}
+
+// Single-source Dijkstra over a 4-connected grid of step costs using decrease_key; returns ns per settled cell
+template <std::size_t Arity>
+double benchGridDijkstra(const std::vector<int>& costs, int side, std::uint64_t& checksum) {
+    using Queue = PriorityQueue<Cell, Arity>;
+    constexpr int UNREACHED = std::numeric_limits<int>::max();
+    const std::size_t cells = costs.size();
+
+    Queue open;
+    open.reserve(static_cast<std::size_t>(side) * 4);
+    std::vector<int> distance(cells, UNREACHED);
+    std::vector<typename Queue::Handle> handles(cells);
+    std::vector<char> settled(cells, 0);
+
+    return nanosPerOp(cells, [&]() {
+        distance[0] = 0;
+        handles[0] = open.push({0, 0, 0});
+        while (!open.empty()) {
+            Cell cell = open.top();
+            open.pop();
+            settled[cell.row * side + cell.col] = 1;
+            checksum += static_cast<std::uint64_t>(cell.cost);
+
+            const int dRow[] = {-1, 1, 0, 0};
+            const int dCol[] = {0, 0, -1, 1};
+            for (int direction = 0; direction < 4; ++direction) {
+                int row = cell.row + dRow[direction];
+                int col = cell.col + dCol[direction];
+                if (row < 0 || col < 0 || row >= side || col >= side) continue;
+
+                std::size_t index = static_cast<std::size_t>(row) * side + col;
+                int candidate = cell.cost + costs[index];
+                if (settled[index] || candidate >= distance[index]) continue;
+
+                if (distance[index] == UNREACHED) {
+                    handles[index] = open.push({row, col, candidate});
+                } else {
+                    open.decrease_key(handles[index], {row, col, candidate});
+                }
+                distance[index] = candidate;
+            }
+        }
+    });
+}
+
+void BenchPriorityQueue() {
+    std::cout << "Benchmarking PriorityQueue arity on grid Dijkstra...\n";
+
+    for (int side : {512, 1024}) {
+        std::mt19937 rng(side);
+        std::vector<int> costs(static_cast<std::size_t>(side) * side);
+        for (auto& cost : costs) cost = 1 + static_cast<int>(rng() % 9);
+
+        std::uint64_t checksum = 0;
+        double binary = benchGridDijkstra<2>(costs, side, checksum);
+        double quaternary = benchGridDijkstra<4>(costs, side, checksum);
+        double octonary = benchGridDijkstra<8>(costs, side, checksum);
+
+        std::cout << side << "x" << side << " grid, random costs 1-9\n"
+                  << "  2-ary " << binary << " ns/cell, 4-ary " << quaternary << " ns/cell, 8-ary "
+                  << octonary << " ns/cell (checksum " << checksum << ")\n";
+    }
+
+    std::cout << "PriorityQueue benchmark completed.\n";
+}
+
+// Same search as benchGridDijkstra on a BucketQueue: improved cells are pushed again and stale
+// entries (cost above the settled distance) are skipped when popped
+double benchGridDijkstraBuckets(const std::vector<int>& costs, int side, std::uint64_t& checksum) {
+    constexpr int UNREACHED = std::numeric_limits<int>::max();
+    const std::size_t cells = costs.size();
+
+    BucketQueue<> open(16);
+    std::vector<int> distance(cells, UNREACHED);
+    std::vector<char> settled(cells, 0);
+
+    return nanosPerOp(cells, [&]() {
+        distance[0] = 0;
+        open.push({0, 0, 0});
+        while (!open.empty()) {
+            Cell cell = open.top();
+            open.pop();
+            std::size_t current = static_cast<std::size_t>(cell.row) * side + cell.col;
+            if (settled[current]) continue;
+            settled[current] = 1;
+            checksum += static_cast<std::uint64_t>(cell.cost);
+
+            const int dRow[] = {-1, 1, 0, 0};
+            const int dCol[] = {0, 0, -1, 1};
+            for (int direction = 0; direction < 4; ++direction) {
+                int row = cell.row + dRow[direction];
+                int col = cell.col + dCol[direction];
+                if (row < 0 || col < 0 || row >= side || col >= side) continue;
+
+                std::size_t index = static_cast<std::size_t>(row) * side + col;
+                int candidate = cell.cost + costs[index];
+                if (settled[index] || candidate >= distance[index]) continue;
+
+                distance[index] = candidate;
+                open.push({row, col, candidate});
+            }
+        }
+    });
+}
+
+void BenchBucketQueue() {
+    std::cout << "Benchmarking BucketQueue against PriorityQueue on grid Dijkstra...\n";
+
+    for (int side : {1024, 4096}) {
+        std::mt19937 rng(side);
+        std::vector<int> costs(static_cast<std::size_t>(side) * side);
+        for (auto& cost : costs) cost = 1 + static_cast<int>(rng() % 9);
+
+        std::uint64_t heapChecksum = 0;
+        std::uint64_t bucketChecksum = 0;
+        double heap = benchGridDijkstra<4>(costs, side, heapChecksum);
+        double buckets = benchGridDijkstraBuckets(costs, side, bucketChecksum);
+
+        std::cout << side << "x" << side << " grid, random costs 1-9\n"
+                  << "  4-ary heap " << heap << " ns/cell, buckets " << buckets << " ns/cell ("
+                  << heap / buckets << "x, checksums " << (heapChecksum == bucketChecksum ? "match" : "differ")
+                  << ")\n";
+    }
+
+    std::cout << "BucketQueue benchmark completed.\n";
+}
+
+void BenchPathfinder() {
+    std::cout << "Benchmarking Pathfinder on a 512x512 map with 25% obstacles...\n";
+
+    const int side = 512;
+    std::mt19937 rng(512);
+    GridMap map(side, side);
+    for (int row = 0; row < side; ++row) {
+        for (int col = 0; col < side; ++col) {
+            if (rng() % 4 == 0) map.setCost(row, col, GridMap::BLOCKED);
+        }
+    }
+
+    std::vector<std::pair<Cell, Cell>> queries;
+    while (queries.size() < 50) {
+        Cell start{static_cast<int>(rng() % side), static_cast<int>(rng() % side), 0};
+        Cell goal{static_cast<int>(rng() % side), static_cast<int>(rng() % side), 0};
+        if (map.passable(start.row, start.col) && map.passable(goal.row, goal.col)) queries.push_back({start, goal});
+    }
+
+    Pathfinder pathfinder(map);
+    std::vector<Cell> path;
+    const char* names[] = {"Dijkstra", "A*", "JPS"};
+    Pathfinder::Algorithm algorithms[] = {Pathfinder::Algorithm::Dijkstra, Pathfinder::Algorithm::AStar,
+                                          Pathfinder::Algorithm::JumpPoint};
+    for (int i = 0; i < 3; ++i) {
+        std::uint64_t checksum = 0;
+        std::size_t expanded = 0;
+        double nanos = nanosPerOp(queries.size(), [&] {
+            for (const auto& [start, goal] : queries) {
+                checksum += static_cast<std::uint64_t>(pathfinder.findPath(start, goal, algorithms[i], path));
+                expanded += pathfinder.expandedCells();
+            }
+        });
+        std::cout << "  " << names[i] << ": " << nanos / 1000.0 << " us/query, " << expanded / queries.size()
+                  << " cells expanded/query (checksum " << checksum << ")\n";
+    }
+
+    std::cout << "Pathfinder benchmark completed.\n";
+}
+
+void BenchHierarchicalPathfinder() {
+    std::cout << "Benchmarking HierarchicalPathfinder on a 4096x4096 world map...\n";
+
+    // Walls and swamps scattered over open ground
+    const int side = 4096;
+    std::mt19937 rng(4096);
+    GridMap map(side, side);
+    for (int wall = 0; wall < 60000; ++wall) {
+        int row = static_cast<int>(rng() % side);
+        int col = static_cast<int>(rng() % side);
+        int length = 4 + static_cast<int>(rng() % 40);
+        bool vertical = rng() % 2;
+        for (int i = 0; i < length; ++i) {
+            int r = vertical ? row + i : row;
+            int c = vertical ? col : col + i;
+            if (map.inBounds(r, c)) map.setCost(r, c, GridMap::BLOCKED);
+        }
+    }
+    for (int swamp = 0; swamp < 3000; ++swamp) {
+        int row = static_cast<int>(rng() % side);
+        int col = static_cast<int>(rng() % side);
+        for (int r = row; r < std::min(row + 24, side); ++r) {
+            for (int c = col; c < std::min(col + 24, side); ++c) {
+                if (map.passable(r, c)) map.setCost(r, c, 4);
+            }
+        }
+    }
+
+    HierarchicalPathfinder hierarchy(map, 32);
+    double buildMs = nanosPerOp(1, [&] { hierarchy.refresh(); }) / 1e6;
+    std::cout << "  Build: " << buildMs << " ms for " << hierarchy.portalCount() << " portals\n";
+
+    std::vector<std::pair<Cell, Cell>> queries;
+    while (queries.size() < 10) {
+        Cell start{static_cast<int>(rng() % side), static_cast<int>(rng() % side), 0};
+        Cell goal{static_cast<int>(rng() % side), static_cast<int>(rng() % side), 0};
+        if (map.passable(start.row, start.col) && map.passable(goal.row, goal.col)) queries.push_back({start, goal});
+    }
+
+    Pathfinder flat(map);
+    std::vector<Cell> path;
+    std::uint64_t flatCost = 0;
+    std::uint64_t waypointCost = 0;
+    std::uint64_t pathCost = 0;
+    double flatNanos = nanosPerOp(queries.size(), [&] {
+        for (const auto& [start, goal] : queries) {
+            flatCost += static_cast<std::uint64_t>(flat.findPath(start, goal, Pathfinder::Algorithm::AStar, path));
+        }
+    });
+    double waypointNanos = nanosPerOp(queries.size(), [&] {
+        for (const auto& [start, goal] : queries) {
+            waypointCost += static_cast<std::uint64_t>(hierarchy.findWaypoints(start, goal, path));
+        }
+    });
+    double pathNanos = nanosPerOp(queries.size(), [&] {
+        for (const auto& [start, goal] : queries) {
+            pathCost += static_cast<std::uint64_t>(hierarchy.findPath(start, goal, path));
+        }
+    });
+    std::cout << "  Flat A*: " << flatNanos / 1e6 << " ms/query\n"
+              << "  HPA* waypoints: " << waypointNanos / 1e6 << " ms/query, refined path: " << pathNanos / 1e6
+              << " ms/query\n"
+              << "  Route cost vs flat A*: +" << 100.0 * (double(pathCost) - double(flatCost)) / double(flatCost)
+              << "% (waypoint and refined costs " << (waypointCost == pathCost ? "match" : "differ") << ")\n";
+
+    // Trips of up to 256 cells, as between neighbouring locations
+    std::vector<std::pair<Cell, Cell>> shortTrips;
+    while (shortTrips.size() < 200) {
+        Cell start{static_cast<int>(rng() % side), static_cast<int>(rng() % side), 0};
+        Cell goal{start.row + static_cast<int>(rng() % 513) - 256, start.col + static_cast<int>(rng() % 513) - 256, 0};
+        if (map.passable(start.row, start.col) && map.passable(goal.row, goal.col)) shortTrips.push_back({start, goal});
+    }
+    double shortNanos = nanosPerOp(shortTrips.size(), [&] {
+        for (const auto& [start, goal] : shortTrips) pathCost += static_cast<std::uint64_t>(hierarchy.findWaypoints(start, goal, path));
+    });
+    std::cout << "  HPA* waypoints for trips up to 256 cells: " << shortNanos / 1e6 << " ms/query\n";
+
+    // Edit one region, then the next query rebuilds only what changed
+    for (int r = 2000; r < 2010; ++r) {
+        for (int c = 2000; c < 2010; ++c) {
+            map.setCost(r, c, GridMap::BLOCKED);
+            hierarchy.cellChanged(r, c);
+        }
+    }
+    double updateMs = nanosPerOp(1, [&] { hierarchy.refresh(); }) / 1e6;
+    std::cout << "  Update after a 10x10 edit: " << updateMs << " ms, " << hierarchy.rebuiltClusters()
+              << " clusters rebuilt\n";
+
+    std::cout << "HierarchicalPathfinder benchmark completed.\n";
+}
+
+void BenchBatchPathfinder() {
+    std::cout << "Benchmarking BatchPathfinder on a 512x512 map with 25% obstacles...\n";
+
+    const int side = 512;
+    std::mt19937 rng(44);
+    GridMap map(side, side);
+    for (int row = 0; row < side; ++row) {
+        for (int col = 0; col < side; ++col) {
+            if (rng() % 4 == 0) map.setCost(row, col, GridMap::BLOCKED);
+        }
+    }
+
+    // NPC-style requests: short trips around random spots
+    std::vector<PathRequest> requests;
+    while (requests.size() < 1024) {
+        Cell start{static_cast<int>(rng() % side), static_cast<int>(rng() % side), 0};
+        Cell goal{start.row + static_cast<int>(rng() % 129) - 64, start.col + static_cast<int>(rng() % 129) - 64, 0};
+        if (map.passable(start.row, start.col) && map.passable(goal.row, goal.col)) requests.push_back({start, goal});
+    }
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    double serial = 0;
+    for (unsigned threads = 1; threads <= std::max(cores, 4u); threads *= 2) {
+        BatchPathfinder batch(map, threads);
+        PathBatch results;
+        batch.findPaths(requests, Pathfinder::Algorithm::AStar, results); // Warm up the buffers
+
+        double nanos = nanosPerOp(requests.size(), [&] { batch.findPaths(requests, Pathfinder::Algorithm::AStar, results); });
+        if (threads == 1) serial = nanos;
+        std::cout << "  " << threads << " thread(s): " << nanos / 1000.0 << " us/path, speedup " << serial / nanos
+                  << "x (" << results.cells.size() << " cells)\n";
+    }
+    std::cout << "  Hardware threads: " << cores << "\n";
+
+    std::cout << "BatchPathfinder benchmark completed.\n";
+}
+
+void BenchFlowField() {
+    std::cout << "Benchmarking FlowField on a 1024x1024 map with 20% obstacles...\n";
+
+    const int side = 1024;
+    std::mt19937 rng(45);
+    GridMap map(side, side);
+    for (int row = 0; row < side; ++row) {
+        for (int col = 0; col < side; ++col) {
+            if (rng() % 5 == 0) map.setCost(row, col, GridMap::BLOCKED);
+        }
+    }
+    Cell goal{side / 2, side / 2, 0};
+    map.setCost(goal.row, goal.col, 1);
+
+    std::vector<Cell> agents;
+    while (agents.size() < 200) {
+        Cell agent{static_cast<int>(rng() % side), static_cast<int>(rng() % side), 0};
+        if (map.passable(agent.row, agent.col)) agents.push_back(agent);
+    }
+
+    FlowField field(map);
+    double buildMs = nanosPerOp(1, [&] { field.build(goal); }) / 1e6;
+
+    Pathfinder pathfinder(map);
+    std::vector<Cell> path;
+    std::uint64_t aStarCost = 0;
+    std::uint64_t fieldCost = 0;
+    double aStarMs = nanosPerOp(1, [&] {
+        for (const Cell& agent : agents) {
+            aStarCost += static_cast<std::uint64_t>(pathfinder.findPath(agent, goal, Pathfinder::Algorithm::AStar, path));
+        }
+    }) / 1e6;
+    for (const Cell& agent : agents) fieldCost += static_cast<std::uint64_t>(field.distance(agent.row, agent.col));
+
+    std::cout << "  Flow field build: " << buildMs << " ms (" << buildMs * 1e6 / (double(side) * side)
+              << " ns/cell), A* for " << agents.size() << " agents: " << aStarMs << " ms (costs "
+              << (aStarCost == fieldCost ? "match" : "differ") << ")\n";
+
+    // A 3x3 rock lands 200 cells from the goal, then a 40-cell wall next to the goal, each removed again
+    std::vector<Cell> changed;
+    for (int row = goal.row - 201; row <= goal.row - 199; ++row) {
+        for (int col = goal.col - 1; col <= goal.col + 1; ++col) changed.push_back({row, col, 0});
+    }
+    for (const Cell& cell : changed) map.setCost(cell.row, cell.col, GridMap::BLOCKED);
+    double rockMs = nanosPerOp(1, [&] { field.update(changed); }) / 1e6;
+    std::size_t rockSettled = field.updatedCells();
+    for (const Cell& cell : changed) map.setCost(cell.row, cell.col, 1);
+    field.update(changed);
+    std::cout << "  Update, 3x3 rock added: " << rockMs << " ms (" << rockSettled << " cells settled)\n";
+
+    changed.clear();
+    for (int col = goal.col - 20; col < goal.col + 20; ++col) changed.push_back({goal.row - 5, col, 0});
+    for (const Cell& cell : changed) map.setCost(cell.row, cell.col, GridMap::BLOCKED);
+    double closeMs = nanosPerOp(1, [&] { field.update(changed); }) / 1e6;
+    std::size_t closeSettled = field.updatedCells();
+    for (const Cell& cell : changed) map.setCost(cell.row, cell.col, 1);
+    double openMs = nanosPerOp(1, [&] { field.update(changed); }) / 1e6;
+    std::cout << "  Update, 40-cell wall added: " << closeMs << " ms (" << closeSettled << " cells settled), removed: "
+              << openMs << " ms (" << field.updatedCells() << " cells settled)\n";
+
+    std::cout << "FlowField benchmark completed.\n";
+}
+
+void BenchItemStore() {
+    std::cout << "Benchmarking ItemStore filters against a vector<Item> scan (1M items)...\n";
+
+    const std::size_t count = 1'000'000;
+    const char* statuses[] = {"Available", "Unavailable", "Reserved"};
+    std::mt19937 rng(46);
+    std::vector<Item> items;
+    items.reserve(count);
+    ItemStore store;
+    store.reserve(count, count * 16);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::vector<std::string> tags = {"tag" + std::to_string(rng() % 40), "tag" + std::to_string(rng() % 40),
+                                         "tag" + std::to_string(rng() % 40)};
+        items.emplace_back("Item number " + std::to_string(i), static_cast<int>(rng() % 10000),
+                           static_cast<int>(rng() % 10000), tags, "Vendor_" + std::to_string(rng() % 500),
+                           static_cast<int>(i), statuses[rng() % 3]);
+        store.add(items.back());
+    }
+
+    std::size_t scanned = 0;
+    double scanPrice = nanosPerOp(count, [&] {
+        for (const Item& item : items) scanned += item.getPrice() >= 2000 && item.getPrice() <= 4000;
+    });
+    ItemSelection selection;
+    double storePrice = nanosPerOp(count, [&] { store.priceBetween(2000, 4000, selection); });
+    std::cout << "  Price range: vector<Item> " << scanPrice << " ns/item, ItemStore " << storePrice << " ns/item ("
+              << (scanned == selection.count() ? "same" : "different") << " result)\n";
+
+    scanned = 0;
+    double scanStatus = nanosPerOp(count, [&] { for (const Item& item : items) scanned += item.getStatus() == "Reserved"; });
+    double storeStatus = nanosPerOp(count, [&] { store.withStatus("Reserved", selection); });
+    std::cout << "  Status: vector<Item> " << scanStatus << " ns/item, ItemStore " << storeStatus << " ns/item ("
+              << (scanned == selection.count() ? "same" : "different") << " result)\n";
+
+    scanned = 0;
+    double scanTags = nanosPerOp(count, [&] {
+        for (const Item& item : items) {
+            const auto& tags = item.getTags();
+            scanned += std::find(tags.begin(), tags.end(), "tag7") != tags.end() &&
+                       std::find(tags.begin(), tags.end(), "tag13") != tags.end();
+        }
+    });
+    std::string_view wanted[] = {"tag7", "tag13"};
+    double storeTags = nanosPerOp(count, [&] { store.withTags(wanted, selection); });
+    std::cout << "  Two tags: vector<Item> " << scanTags << " ns/item, ItemStore " << storeTags << " ns/item ("
+              << (scanned == selection.count() ? "same" : "different") << " result)\n";
+
+    std::cout << "ItemStore benchmark completed.\n";
+}
+
+void BenchItemLoader() {
+    std::cout << "Benchmarking item catalog loading (1M lines)...\n";
+
+    const char* statuses[] = {"Available", "Unavailable", "Reserved"};
+    std::mt19937 rng(47);
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "esprit_items_bench.txt";
+    {
+        std::ofstream file(path, std::ios::binary);
+        for (int i = 0; i < 1'000'000; ++i) {
+            file << "Item number " << i << "," << rng() % 10000 << "," << rng() % 10000 << ",tag" << rng() % 40
+                 << "|tag" << rng() % 40 << "|tag" << rng() % 40 << ",Vendor_" << rng() % 500 << "," << i << ","
+                 << statuses[rng() % 3] << "\n";
+        }
+    }
+    double megabytes = static_cast<double>(std::filesystem::file_size(path)) / 1e6;
+
+    std::vector<Item> items;
+    double streamMs = nanosPerOp(1, [&] { items = parseItemsFromFile(path.string()); }) / 1e6;
+    ItemStore store;
+    double mappedMs = nanosPerOp(1, [&] { loadItems(path.string(), store); }) / 1e6;
+    std::cout << "  parseItemsFromFile: " << streamMs << " ms (" << megabytes / streamMs * 1e3 << " MB/s), loadItems: "
+              << mappedMs << " ms (" << megabytes / mappedMs * 1e3 << " MB/s), "
+              << (items.size() == store.size() ? "same" : "different") << " item count\n";
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    ItemStore parallel;
+    double parallelMs = nanosPerOp(1, [&] { loadItemsParallel(path.string(), parallel, threads); }) / 1e6;
+    std::cout << "  loadItemsParallel on " << threads << " threads: " << parallelMs << " ms ("
+              << megabytes / parallelMs * 1e3 << " MB/s), " << (parallel.size() == store.size() ? "same" : "different")
+              << " item count\n";
+
+    std::filesystem::remove(path);
+    std::cout << "ItemLoader benchmark completed.\n";
+}
+
+void BenchItemCatalog() {
+    std::cout << "Benchmarking ItemCatalog cold start against text parsing (1M items)...\n";
+
+    const char* statuses[] = {"Available", "Unavailable", "Reserved"};
+    std::mt19937 rng(49);
+    std::filesystem::path textPath = std::filesystem::temp_directory_path() / "esprit_catalog_bench.txt";
+    std::filesystem::path catalogPath = std::filesystem::temp_directory_path() / "esprit_catalog_bench.bin";
+    {
+        std::ofstream file(textPath, std::ios::binary);
+        for (int i = 0; i < 1'000'000; ++i) {
+            file << "Item number " << i << "," << rng() % 10000 << "," << rng() % 10000 << ",tag" << rng() % 40
+                 << "|tag" << rng() % 40 << ",Vendor_" << rng() % 500 << "," << rng() % 5'000'000 << ","
+                 << statuses[rng() % 3] << "\n";
+        }
+    }
+
+    double convertMs = nanosPerOp(1, [&] { ItemCatalog::convert(textPath.string(), catalogPath.string()); }) / 1e6;
+    ItemStore store;
+    double parseMs = nanosPerOp(1, [&] { loadItems(textPath.string(), store); }) / 1e6;
+    std::size_t opened = 0;
+    double openUs = nanosPerOp(1, [&] { opened = ItemCatalog(catalogPath.string()).size(); }) / 1e3;
+    std::cout << "  Text load: " << parseMs << " ms, catalog open: " << openUs << " us (" << opened
+              << " items), one-time conversion: " << convertMs << " ms\n";
+
+    ItemCatalog catalog(catalogPath.string());
+    ItemSelection selection;
+    double filterNs = nanosPerOp(catalog.size(), [&] { catalog.priceBetween(2000, 4000, selection); });
+    std::size_t found = 0;
+    double findNs = nanosPerOp(100'000, [&] {
+        for (int i = 0; i < 100'000; ++i) found += catalog.find(static_cast<std::int32_t>(rng() % 5'000'000)) != ItemCatalog::NO_ITEM;
+    });
+    std::cout << "  First price filter from the mapping: " << filterNs << " ns/item, find by code: " << findNs
+              << " ns (" << found << " hits)\n";
+
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(catalogPath);
+    std::cout << "ItemCatalog benchmark completed.\n";
+}
+
+void BenchTagIndex() {
+    std::cout << "Benchmarking TagIndex queries (1M items, 200 tags with skewed popularity)...\n";
+
+    const std::size_t count = 1'000'000;
+    std::mt19937 rng(50);
+    std::vector<Item> items;
+    items.reserve(count);
+    ItemStore store;
+    for (std::size_t i = 0; i < count; ++i) {
+        // Tag k is carried by about 1 item in (k + 2): a few common tags and a long tail of rare ones
+        std::vector<std::string> tags;
+        for (int tag = 0; tag < 200 && tags.size() < 6; ++tag) {
+            if (rng() % static_cast<unsigned>(tag + 2) == 0) tags.push_back("tag" + std::to_string(tag));
+        }
+        items.emplace_back("Item " + std::to_string(i), 0, 0, tags, "Vendor", static_cast<int>(i), "Available");
+        store.add(items.back());
+    }
+
+    TagIndex index;
+    double buildMs = nanosPerOp(1, [&] { index = TagIndex(store); }) / 1e6;
+    std::size_t postingBytes = 0;
+    for (int tag = 0; tag < 200; ++tag) postingBytes += index.postings("tag" + std::to_string(tag)).memoryBytes();
+    std::cout << "  Build: " << buildMs << " ms, posting lists: " << postingBytes / 1024 << " KB (tag bitsets in "
+              << "ItemStore: " << store.tagColumn().size() * 8 / 1024 << " KB)\n";
+
+    struct Case {
+        const char* query;
+        std::vector<std::string_view> all; // The same query for ItemStore::withTags, when it is a plain AND
+    };
+    const Case cases[] = {{"tag0 AND tag1", {"tag0", "tag1"}},
+                          {"tag0 AND tag150", {"tag0", "tag150"}},
+                          {"tag120 AND tag150", {"tag120", "tag150"}},
+                          {"(tag3 OR tag4) AND NOT tag0", {}}};
+    for (const Case& test : cases) {
+        std::size_t matches = 0;
+        double indexUs = nanosPerOp(100, [&] {
+            for (int repeat = 0; repeat < 100; ++repeat) matches = index.query(test.query).cardinality();
+        }) / 1e3;
+        std::cout << "  " << test.query << ": index " << indexUs << " us (" << matches << " items)";
+        if (!test.all.empty()) {
+            ItemSelection selection;
+            double bitsetUs = nanosPerOp(10, [&] {
+                for (int repeat = 0; repeat < 10; ++repeat) store.withTags(test.all, selection);
+            }) / 1e3;
+            std::size_t scanned = 0;
+            double scanUs = nanosPerOp(1, [&] {
+                for (const Item& item : items) {
+                    const auto& tags = item.getTags();
+                    bool all = true;
+                    for (std::string_view tag : test.all) all = all && std::find(tags.begin(), tags.end(), tag) != tags.end();
+                    scanned += all;
+                }
+            }) / 1e3;
+            std::cout << ", ItemStore bitset scan " << bitsetUs << " us, vector<Item> scan " << scanUs << " us ("
+                      << (scanned == matches && selection.count() == matches ? "same" : "different") << " result)";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "TagIndex benchmark completed.\n";
+}
+
+#endif //PROJECT_ESPRIT_MODEL_C_BENCHUNIT_H
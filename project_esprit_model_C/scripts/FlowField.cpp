@@ -0,0 +1,197 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#include "FlowField.h"
+#include <algorithm>
+
+FlowField::FlowField(const GridMap& map) : map(map), stride(map.cols() + 2), open(32) {
+    std::size_t cells = static_cast<std::size_t>(map.rows() + 2) * stride;
+    distances.assign(cells, FAR);
+    entryCosts.assign(cells, 0);
+    walls.assign(cells, FAR);
+    directions.assign(cells, NONE);
+    rowBest.resize(map.cols());
+    rowDirection.resize(map.cols());
+    for (int d = 0; d < 8; ++d) offsets[d] = ROW_STEP[d] * stride + COL_STEP[d];
+}
+
+int FlowField::distance(int row, int col) const {
+    int value = distances[slot(row, col)];
+    return value >= FAR ? Pathfinder::NO_PATH : value;
+}
+
+void FlowField::copyCell(int row, int col) {
+    int index = slot(row, col);
+    bool passable = map.passable(row, col);
+    entryCosts[index] = passable ? map.cost(row, col) : 0;
+    walls[index] = passable ? 0 : FAR;
+}
+
+void FlowField::touch(int index) {
+    int row = index / stride - 1;
+    int col = index % stride - 1;
+    touchedTop = std::min(touchedTop, row);
+    touchedBottom = std::max(touchedBottom, row + 1);
+    touchedLeft = std::min(touchedLeft, col);
+    touchedRight = std::max(touchedRight, col + 1);
+}
+
+bool FlowField::canStep(int from, int d) const {
+    if (walls[from + offsets[d]]) return false;
+    return d < 4 || (!walls[from + ROW_STEP[d] * stride] && !walls[from + COL_STEP[d]]);
+}
+
+void FlowField::build(const Cell& goal) {
+    std::fill(distances.begin(), distances.end(), FAR);
+    for (int row = 0; row < map.rows(); ++row) {
+        for (int col = 0; col < map.cols(); ++col) copyCell(row, col);
+    }
+
+    open.clear();
+    updated = 0;
+    touchedTop = touchedLeft = 0;
+    touchedBottom = map.rows();
+    touchedRight = map.cols();
+    goalSlot = map.inBounds(goal.row, goal.col) ? slot(goal.row, goal.col) : -1; // Kept even if blocked for now
+    if (map.passable(goal.row, goal.col)) {
+        distances[goalSlot] = 0;
+        open.push({goalSlot, 0});
+        propagate();
+    }
+    directionPass(0, map.rows(), 0, map.cols());
+}
+// Complexity: O(rows * cols)
+
+// Reverse Dijkstra: a settled cell v offers every neighbour u the cost of stepping from u into v
+void FlowField::propagate() {
+    while (!open.empty()) {
+        Queued entry = open.top();
+        open.pop();
+        if (entry.cost > distances[entry.slot]) continue; // Superseded by a cheaper entry
+        ++updated;
+
+        for (int d = 0; d < 8; ++d) {
+            int from = entry.slot - offsets[d];
+            if (walls[from] || !canStep(from, d)) continue;
+
+            int candidate = entry.cost + WEIGHT[d] * entryCosts[entry.slot];
+            if (candidate >= distances[from]) continue;
+            distances[from] = candidate;
+            open.push({from, candidate});
+            touch(from);
+        }
+    }
+}
+
+// Every cell picks the neighbour minimizing (neighbour distance + step cost). The loops run one
+// direction at a time over a whole row with no branches (walls add FAR instead of being skipped),
+// so each inner loop is a contiguous, vectorizable sweep.
+void FlowField::directionPass(int rowBegin, int rowEnd, int colBegin, int colEnd) {
+    int width = colEnd - colBegin;
+    if (width <= 0) return;
+
+    int* best = rowBest.data();
+    std::uint8_t* chosen = rowDirection.data();
+    const int* distance = distances.data();
+    const int* entry = entryCosts.data();
+    const int* wall = walls.data();
+
+    for (int row = rowBegin; row < rowEnd; ++row) {
+        int base = slot(row, colBegin);
+        std::fill(best, best + width, INT32_MAX);
+        std::fill(chosen, chosen + width, NONE);
+
+        for (int d = 0; d < 8; ++d) {
+            const int* neighbourDistance = distance + base + offsets[d];
+            const int* neighbourEntry = entry + base + offsets[d];
+            const int* rowWall = wall + base + ROW_STEP[d] * stride; // Corner cells of a diagonal step
+            const int* colWall = wall + base + COL_STEP[d];
+            int weight = WEIGHT[d];
+            int corner = d < 4 ? 0 : 1;
+            auto direction = static_cast<std::uint8_t>(d);
+
+            for (int i = 0; i < width; ++i) {
+                int candidate = neighbourDistance[i] + weight * neighbourEntry[i] + corner * (rowWall[i] + colWall[i]);
+                bool better = candidate < best[i];
+                best[i] = better ? candidate : best[i];
+                chosen[i] = better ? direction : chosen[i];
+            }
+        }
+
+        std::uint8_t* out = directions.data() + base;
+        const int* own = distance + base;
+        for (int i = 0; i < width; ++i) {
+            bool moves = own[i] > 0 && own[i] < FAR && best[i] < FAR;
+            out[i] = moves ? chosen[i] : NONE;
+        }
+    }
+}
+// Complexity: O(8 * rows * cols)
+
+void FlowField::update(std::span<const Cell> changed) {
+    updated = 0;
+    touchedTop = touchedLeft = INT32_MAX;
+    touchedBottom = touchedRight = INT32_MIN;
+    invalidated.clear();
+
+    // Forget every distance that relied on a changed cell: cells whose direction points into it or
+    // whose diagonal step cuts its corner, then everything whose direction leads into those
+    auto invalidate = [&](int index) {
+        if (distances[index] >= FAR) return;
+        distances[index] = FAR;
+        invalidated.push_back(index);
+    };
+    for (const Cell& cell : changed) {
+        copyCell(cell.row, cell.col);
+        int index = slot(cell.row, cell.col);
+        touch(index);
+        invalidate(index);
+        for (int d = 4; d < 8; ++d) {
+            // Neighbours stepping diagonally past this cell: (row - d.row, col) and (row, col - d.col)
+            int aside = index - ROW_STEP[d] * stride;
+            int below = index - COL_STEP[d];
+            if (directions[aside] == d) invalidate(aside);
+            if (directions[below] == d) invalidate(below);
+        }
+    }
+    for (std::size_t i = 0; i < invalidated.size(); ++i) {
+        int index = invalidated[i];
+        touch(index);
+        for (int d = 0; d < 8; ++d) {
+            int from = index - offsets[d];
+            if (directions[from] == d) invalidate(from);
+        }
+    }
+
+    // Reseed each forgotten (or changed) cell from its neighbours that kept their distance
+    open.clear();
+    auto reseed = [&](int index) {
+        if (walls[index]) return;
+        int best = index == goalSlot ? 0 : FAR;
+        for (int d = 0; d < 8; ++d) {
+            int to = index + offsets[d];
+            if (distances[to] < FAR && canStep(index, d)) {
+                best = std::min(best, distances[to] + WEIGHT[d] * entryCosts[to]);
+            }
+        }
+        if (best < distances[index]) distances[index] = best;
+        if (distances[index] < FAR) open.push({index, distances[index]});
+    };
+    for (int index : invalidated) reseed(index);
+    for (const Cell& cell : changed) {
+        // A cheaper cell lowers the cells stepping into it, and an opened one makes diagonal steps
+        // past its corner legal, so its neighbours relax again too
+        int index = slot(cell.row, cell.col);
+        reseed(index);
+        for (int d = 0; d < 8; ++d) {
+            int neighbour = index + offsets[d];
+            if (distances[neighbour] < FAR) open.push({neighbour, distances[neighbour]});
+        }
+    }
+    propagate();
+
+    directionPass(std::max(touchedTop - 1, 0), std::min(touchedBottom + 1, map.rows()),
+                  std::max(touchedLeft - 1, 0), std::min(touchedRight + 1, map.cols()));
+}
+// Complexity: O(a log a) for a affected cells, plus their bounding box for directions
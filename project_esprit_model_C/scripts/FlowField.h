@@ -0,0 +1,87 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_FLOWFIELD_H
+#define PROJECT_ESPRIT_MODEL_C_FLOWFIELD_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Pathfinder.h"
+#include "../data_structures/BucketQueue.h"
+
+// Distance and direction to one goal for every cell of a GridMap, for crowds heading to the same
+// place: one reverse Dijkstra from the goal replaces an A* search per agent, and each agent then just
+// follows direction() from its cell. Costs follow Pathfinder (10/14 per step times the entered cell's
+// cost, no corner cutting).
+// Data is kept as separate arrays (distance, entry cost, wall mask, direction) over the grid padded
+// with a ring of walls, so neighbour lookups need no bounds checks and the direction pass is a set of
+// straight loops over contiguous rows that the compiler can vectorize. Distances must stay below
+// 2^29, far beyond any route on maps this game uses.
+class FlowField {
+public:
+    static constexpr std::uint8_t NONE = 8; // Direction of the goal, walls and unreachable cells
+    static constexpr int ROW_STEP[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+    static constexpr int COL_STEP[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+
+    explicit FlowField(const GridMap& map);
+
+    // Compute the whole field towards `goal`. A blocked goal leaves every cell unreachable until an
+    // update opens it.
+    void build(const Cell& goal);
+
+    // Bring the field up to date after the costs of `changed` cells were modified in the map.
+    // Only the cells whose best route went through (or cut the corner of) a changed cell are
+    // recomputed, plus whatever gets cheaper; directions are refreshed around them.
+    void update(std::span<const Cell> changed);
+
+    // Cost of the cheapest route from this cell to the goal, or Pathfinder::NO_PATH
+    int distance(int row, int col) const;
+
+    // Index into ROW_STEP/COL_STEP of the first step towards the goal, or NONE
+    std::uint8_t direction(int row, int col) const { return directions[slot(row, col)]; }
+
+    // Cells settled by the last build or update
+    std::size_t updatedCells() const { return updated; }
+
+private:
+    static constexpr int FAR = 1 << 29; // Unreachable distance and wall penalty; 3 * FAR fits an int
+    static constexpr int WEIGHT[8] = {10, 10, 10, 10, 14, 14, 14, 14};
+
+    struct Queued {
+        int slot;
+        int cost;
+    };
+
+    const GridMap& map;
+    int stride; // Padded row length
+    int goalSlot = -1;
+    std::vector<int> distances;             // FAR when unreachable
+    std::vector<int> entryCosts;            // Cost of entering each cell, 0 for walls
+    std::vector<int> walls;                 // FAR for walls and padding, 0 for open cells
+    std::vector<std::uint8_t> directions;
+    int offsets[8];                         // Slot delta of each direction
+
+    BucketQueue<Queued> open;
+    std::vector<int> invalidated;
+    std::vector<int> rowBest;               // Scratch rows for the direction pass
+    std::vector<std::uint8_t> rowDirection;
+    std::size_t updated = 0;
+    int touchedTop = 0, touchedLeft = 0, touchedBottom = 0, touchedRight = 0; // Rows/columns whose distances changed
+
+    int slot(int row, int col) const { return (row + 1) * stride + col + 1; }
+    void copyCell(int row, int col);
+    void touch(int slot);
+
+    // A step from `from` in direction d: the target must be open and a diagonal may not cut a wall
+    bool canStep(int from, int d) const;
+
+    // Settle everything queued, lowering distances with the reverse step costs
+    void propagate();
+
+    // Recompute directions for rows [rowBegin, rowEnd) and columns [colBegin, colEnd)
+    void directionPass(int rowBegin, int rowEnd, int colBegin, int colEnd);
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_FLOWFIELD_H
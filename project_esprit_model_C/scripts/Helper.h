@@ -19,6 +19,8 @@ std::string buildDisplayedText(const std::vector<std::string>& lines);
 std::string getFormattedDateTime();
 std::string trim(const std::string& str);
 std::vector<std::string> sliceStringByChar(const std::string&, char);
+std::vector<std::string> split(const std::string& str, char delimiter);
+std::vector<Item> parseItemsFromFile(const std::string& filePath);
 
 #endif //PROJECT_ESPRIT_MODEL_C_HELPER_H
 
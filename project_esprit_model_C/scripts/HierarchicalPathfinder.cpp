@@ -0,0 +1,438 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#include "HierarchicalPathfinder.h"
+#include <algorithm>
+#include <stdexcept>
+
+HierarchicalPathfinder::HierarchicalPathfinder(const GridMap& map, int clusterSize) : map(map), size(clusterSize) {
+    if (clusterSize < 2) throw std::invalid_argument("HierarchicalPathfinder clusters need at least 2x2 cells");
+
+    clusterRows = (map.rows() + size - 1) / size;
+    clusterCols = (map.cols() + size - 1) / size;
+    clusters.resize(static_cast<std::size_t>(clusterRows) * clusterCols);
+    for (int clusterRow = 0; clusterRow < clusterRows; ++clusterRow) {
+        for (int clusterCol = 0; clusterCol < clusterCols; ++clusterCol) {
+            Cluster& cluster = clusters[clusterRow * clusterCols + clusterCol];
+            cluster.top = clusterRow * size;
+            cluster.left = clusterCol * size;
+            cluster.bottom = std::min(cluster.top + size, map.rows());
+            cluster.right = std::min(cluster.left + size, map.cols());
+        }
+    }
+    pendingPortals.resize(clusters.size());
+
+    std::size_t cells = static_cast<std::size_t>(size) * size;
+    localCost.assign(cells, UNREACHED);
+    localParent.assign(cells, -1);
+}
+
+int HierarchicalPathfinder::portalSlot(const Cluster& cluster, int mapIndex) const {
+    return static_cast<int>(std::lower_bound(cluster.portals.begin(), cluster.portals.end(), mapIndex) -
+                            cluster.portals.begin());
+}
+
+int HierarchicalPathfinder::cellSlot(const Cluster& cluster, int mapIndex) const {
+    return (mapIndex / map.cols() - cluster.top) * size + mapIndex % map.cols() - cluster.left;
+}
+
+void HierarchicalPathfinder::cellChanged(int row, int col) {
+    if (!map.inBounds(row, col)) throw std::out_of_range("HierarchicalPathfinder cell out of bounds");
+    Cluster& cluster = clusters[clusterOf(row, col)];
+    if (!cluster.dirty) dirtyClusters.push_back(clusterOf(row, col));
+    cluster.dirty = true;
+}
+
+int HierarchicalPathfinder::neighbourAcross(int border) const {
+    return border % 2 == 0 ? border / 2 + 1 : border / 2 + clusterCols;
+}
+
+// Place portals on the open stretches of one border: one in the middle of a short stretch, one at
+// each end of a long one. Between the ends of a long stretch, every window of PORTAL_WINDOW cells
+// whose crossing costs differ also gets a portal at its cheapest crossing, so routes over weighted
+// terrain are not forced through the corners. Only cells open on both sides of the border count.
+void HierarchicalPathfinder::scanBorder(int border, std::vector<std::pair<int, int>>& portals) const {
+    const Cluster& cluster = clusters[border / 2];
+    bool vertical = border % 2 == 0;
+    int fixed = vertical ? cluster.right - 1 : cluster.bottom - 1;
+    int from = vertical ? cluster.top : cluster.left;
+    int to = vertical ? cluster.bottom : cluster.right;
+
+    auto cellAt = [&](int along, int offset) {
+        return vertical ? map.index(along, fixed + offset) : map.index(fixed + offset, along);
+    };
+    auto open = [&](int along) {
+        return vertical ? map.passable(along, fixed) && map.passable(along, fixed + 1)
+                        : map.passable(fixed, along) && map.passable(fixed + 1, along);
+    };
+    auto crossingCost = [&](int along) {
+        return vertical ? map.cost(along, fixed) + map.cost(along, fixed + 1)
+                        : map.cost(fixed, along) + map.cost(fixed + 1, along);
+    };
+    auto place = [&](int along) { portals.push_back({cellAt(along, 0), cellAt(along, 1)}); };
+
+    portals.clear();
+    int along = from;
+    while (along < to) {
+        if (!open(along)) {
+            ++along;
+            continue;
+        }
+        int begin = along;
+        while (along < to && open(along)) ++along;
+
+        if (along - begin >= LONG_BORDER) {
+            place(begin);
+            for (int window = begin + 1; window < along - 1; window += PORTAL_WINDOW) {
+                int windowEnd = std::min(window + PORTAL_WINDOW, along - 1);
+                int cheapest = window;
+                int dearest = crossingCost(window);
+                for (int cell = window + 1; cell < windowEnd; ++cell) {
+                    int cost = crossingCost(cell);
+                    if (cost < crossingCost(cheapest)) cheapest = cell;
+                    dearest = std::max(dearest, cost);
+                }
+                if (crossingCost(cheapest) < dearest) place(cheapest);
+            }
+            place(along - 1);
+        } else {
+            place(begin + (along - begin) / 2);
+        }
+    }
+}
+// Complexity: O(s) for clusters of side s
+
+void HierarchicalPathfinder::computeCosts(Cluster& cluster) {
+    std::size_t portals = cluster.portals.size();
+    cluster.costs.assign(portals * portals, UNREACHED);
+    for (std::size_t from = 0; from < portals; ++from) {
+        localSearch(cluster, cluster.portals[from], false);
+        for (std::size_t to = 0; to < portals; ++to) {
+            cluster.costs[from * portals + to] = localCost[cellSlot(cluster, cluster.portals[to])];
+        }
+    }
+    ++rebuilt;
+}
+// Complexity: O(k * s^2) for k portals in an s x s cluster
+
+// Renumber the portal graph from the cached borders. Cost tables are recomputed only for clusters
+// that are dirty or whose portal list came out different.
+void HierarchicalPathfinder::buildGraph() {
+    for (auto& portals : pendingPortals) portals.clear();
+    for (std::size_t border = 0; border < borders.size(); ++border) {
+        for (const auto& [inside, across] : borders[border]) {
+            pendingPortals[border / 2].push_back(inside);
+            pendingPortals[neighbourAcross(static_cast<int>(border))].push_back(across);
+        }
+    }
+
+    firstNode.assign(clusters.size() + 1, 0);
+    nodeCell.clear();
+    nodeCluster.clear();
+    for (std::size_t index = 0; index < clusters.size(); ++index) {
+        Cluster& cluster = clusters[index];
+        std::vector<int>& portals = pendingPortals[index];
+        std::sort(portals.begin(), portals.end());
+        portals.erase(std::unique(portals.begin(), portals.end()), portals.end());
+
+        if (cluster.dirty || portals != cluster.portals) {
+            cluster.portals.swap(portals);
+            computeCosts(cluster);
+        }
+
+        firstNode[index] = static_cast<int>(nodeCell.size());
+        for (int cell : cluster.portals) {
+            nodeCell.push_back(cell);
+            nodeCluster.push_back(static_cast<int>(index));
+        }
+    }
+    firstNode[clusters.size()] = static_cast<int>(nodeCell.size());
+
+    // Crossings in compressed rows: count per node, prefix sum, then fill
+    auto nodeOf = [&](int cell) {
+        int cluster = clusterOf(cell / map.cols(), cell % map.cols());
+        return firstNode[cluster] + portalSlot(clusters[cluster], cell);
+    };
+    std::size_t nodes = nodeCell.size();
+    crossingStart.assign(nodes + 1, 0);
+    for (const auto& portals : borders) {
+        for (const auto& [inside, across] : portals) {
+            ++crossingStart[nodeOf(inside) + 1];
+            ++crossingStart[nodeOf(across) + 1];
+        }
+    }
+    for (std::size_t node = 0; node < nodes; ++node) crossingStart[node + 1] += crossingStart[node];
+
+    crossings.resize(crossingStart[nodes]);
+    std::vector<int> fill(crossingStart.begin(), crossingStart.end() - 1);
+    for (const auto& portals : borders) {
+        for (const auto& [inside, across] : portals) {
+            int from = nodeOf(inside);
+            int to = nodeOf(across);
+            crossings[fill[from]++] = {to, Pathfinder::STRAIGHT_COST * map.cost(across / map.cols(), across % map.cols())};
+            crossings[fill[to]++] = {from, Pathfinder::STRAIGHT_COST * map.cost(inside / map.cols(), inside % map.cols())};
+        }
+    }
+
+    // One extra slot for the virtual goal node
+    nodeCost.assign(nodes + 1, UNREACHED);
+    nodeParent.assign(nodes + 1, -1);
+    nodeClosed.assign(nodes + 1, 0);
+}
+// Complexity: O(V + E) plus the recomputed cost tables
+
+// Crossing costs pay for entering the portal cell, so refresh every crossing into this cluster's
+// portals (and out of them, in case the other side changed too)
+void HierarchicalPathfinder::updateCrossingCosts(int cluster) {
+    auto stepInto = [&](int node) {
+        return Pathfinder::STRAIGHT_COST * map.cost(nodeCell[node] / map.cols(), nodeCell[node] % map.cols());
+    };
+    for (int node = firstNode[cluster]; node < firstNode[cluster + 1]; ++node) {
+        for (int edge = crossingStart[node]; edge < crossingStart[node + 1]; ++edge) {
+            int other = crossings[edge].to;
+            crossings[edge].cost = stepInto(other);
+            for (int back = crossingStart[other]; back < crossingStart[other + 1]; ++back) {
+                if (crossings[back].to == node) crossings[back].cost = stepInto(node);
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::refresh() {
+    if (built && dirtyClusters.empty()) return;
+    rebuilt = 0;
+
+    bool portalsMoved = !built;
+    if (!built) {
+        borders.resize(clusters.size() * 2);
+        for (std::size_t border = 0; border < borders.size(); ++border) {
+            int cluster = static_cast<int>(border / 2);
+            bool vertical = border % 2 == 0;
+            bool hasNeighbour = vertical ? cluster % clusterCols + 1 < clusterCols : cluster / clusterCols + 1 < clusterRows;
+            if (hasNeighbour) scanBorder(static_cast<int>(border), borders[border]);
+        }
+        built = true;
+    } else {
+        // Only the borders of changed clusters can have moved
+        for (int cluster : dirtyClusters) {
+            int clusterRow = cluster / clusterCols;
+            int clusterCol = cluster % clusterCols;
+            int touching[4] = {-1, -1, -1, -1};
+            if (clusterCol + 1 < clusterCols) touching[0] = 2 * cluster;
+            if (clusterRow + 1 < clusterRows) touching[1] = 2 * cluster + 1;
+            if (clusterCol > 0) touching[2] = 2 * (cluster - 1);
+            if (clusterRow > 0) touching[3] = 2 * (cluster - clusterCols) + 1;
+
+            for (int border : touching) {
+                if (border < 0) continue;
+                scanBorder(border, rescanned);
+                if (rescanned != borders[border]) {
+                    borders[border].swap(rescanned);
+                    portalsMoved = true;
+                }
+            }
+        }
+    }
+
+    if (portalsMoved) {
+        buildGraph();
+    } else {
+        // Same portals everywhere: patch the changed clusters in place
+        for (int cluster : dirtyClusters) {
+            computeCosts(clusters[cluster]);
+            updateCrossingCosts(cluster);
+        }
+    }
+
+    for (auto& cluster : clusters) cluster.dirty = false;
+    dirtyClusters.clear();
+}
+
+void HierarchicalPathfinder::localSearch(const Cluster& cluster, int source, bool reverse) {
+    std::fill(localCost.begin(), localCost.end(), UNREACHED);
+    localOpen.clear();
+
+    int sourceSlot = cellSlot(cluster, source);
+    localCost[sourceSlot] = 0;
+    localParent[sourceSlot] = -1;
+    localOpen.push({source / map.cols(), source % map.cols(), 0});
+
+    while (!localOpen.empty()) {
+        Cell cell = localOpen.top();
+        localOpen.pop();
+        int slot = (cell.row - cluster.top) * size + cell.col - cluster.left;
+        if (cell.cost > localCost[slot]) continue; // Superseded by a cheaper entry
+
+        for (int rowStep = -1; rowStep <= 1; ++rowStep) {
+            for (int colStep = -1; colStep <= 1; ++colStep) {
+                int row = cell.row + rowStep;
+                int col = cell.col + colStep;
+                if ((!rowStep && !colStep) || row < cluster.top || row >= cluster.bottom || col < cluster.left ||
+                    col >= cluster.right || !map.passable(row, col)) {
+                    continue;
+                }
+                bool diagonal = rowStep && colStep;
+                if (diagonal && (!map.passable(row, cell.col) || !map.passable(cell.row, col))) continue;
+
+                // Forward pays for entering the neighbour; reverse walks the step backwards, so the
+                // step from the neighbour into this cell pays for this cell
+                int entered = reverse ? map.cost(cell.row, cell.col) : map.cost(row, col);
+                int candidate = cell.cost + (diagonal ? Pathfinder::DIAGONAL_COST : Pathfinder::STRAIGHT_COST) * entered;
+                int next = (row - cluster.top) * size + col - cluster.left;
+                if (candidate >= localCost[next]) continue;
+
+                localCost[next] = candidate;
+                localParent[next] = slot;
+                localOpen.push({row, col, candidate});
+            }
+        }
+    }
+}
+// Complexity: O(s^2) for an s x s cluster
+
+int HierarchicalPathfinder::search(const Cell& start, const Cell& goal) {
+    refresh();
+    route.clear();
+
+    int startCluster = clusterOf(start.row, start.col);
+    int goalCluster = clusterOf(goal.row, goal.col);
+    const Cluster& from = clusters[startCluster];
+    const Cluster& to = clusters[goalCluster];
+
+    localSearch(from, map.index(start.row, start.col), false);
+    int best = startCluster == goalCluster ? localCost[cellSlot(from, map.index(goal.row, goal.col))] : UNREACHED;
+    startCosts.clear();
+    for (int cell : from.portals) startCosts.push_back(localCost[cellSlot(from, cell)]);
+
+    localSearch(to, map.index(goal.row, goal.col), true);
+    goalCosts.clear();
+    for (int cell : to.portals) goalCosts.push_back(localCost[cellSlot(to, cell)]);
+
+    // A* over portals plus a virtual goal node reached from every portal of the goal cluster. The
+    // octile heuristic stays consistent because every edge cost is a real path cost.
+    int goalNode = static_cast<int>(nodeCell.size());
+    auto relax = [&](int node, int cost, int parent) {
+        if (nodeClosed[node] || cost >= nodeCost[node]) return;
+
+        if (nodeCost[node] == UNREACHED) touched.push_back(node);
+        nodeCost[node] = cost;
+        nodeParent[node] = parent;
+
+        int estimate = cost;
+        if (node != goalNode) {
+            int cell = nodeCell[node];
+            estimate += Pathfinder::octile(cell / map.cols() - goal.row, cell % map.cols() - goal.col);
+        }
+        abstractOpen.push({node, estimate});
+    };
+
+    for (std::size_t slot = 0; slot < startCosts.size(); ++slot) {
+        if (startCosts[slot] != UNREACHED) relax(firstNode[startCluster] + static_cast<int>(slot), startCosts[slot], -1);
+    }
+
+    while (!abstractOpen.empty()) {
+        auto [node, estimate] = abstractOpen.top();
+        abstractOpen.pop();
+        if (nodeClosed[node]) continue; // Superseded by a cheaper entry
+        if (estimate >= best) break;    // The direct in-cluster route is at least as good
+        nodeClosed[node] = 1;
+
+        if (node == goalNode) {
+            best = nodeCost[node];
+            for (int step = nodeParent[node]; step >= 0; step = nodeParent[step]) route.push_back(step);
+            break;
+        }
+
+        int cluster = nodeCluster[node];
+        int slot = node - firstNode[cluster];
+        const Cluster& current = clusters[cluster];
+        std::size_t portals = current.portals.size();
+        for (std::size_t other = 0; other < portals; ++other) {
+            int cost = current.costs[slot * portals + other];
+            if (cost != UNREACHED && static_cast<int>(other) != slot) {
+                relax(firstNode[cluster] + static_cast<int>(other), nodeCost[node] + cost, node);
+            }
+        }
+        for (int edge = crossingStart[node]; edge < crossingStart[node + 1]; ++edge) {
+            relax(crossings[edge].to, nodeCost[node] + crossings[edge].cost, node);
+        }
+        if (cluster == goalCluster && goalCosts[slot] != UNREACHED) {
+            relax(goalNode, nodeCost[node] + goalCosts[slot], node);
+        }
+    }
+
+    return best == UNREACHED ? NO_PATH : best;
+}
+// Complexity: O(s^2 + E) over the portal graph
+
+void HierarchicalPathfinder::resetSearch() {
+    for (int node : touched) {
+        nodeCost[node] = UNREACHED;
+        nodeClosed[node] = 0;
+    }
+    touched.clear();
+    abstractOpen.clear();
+}
+
+int HierarchicalPathfinder::findWaypoints(const Cell& start, const Cell& goal, std::vector<Cell>& waypoints) {
+    waypoints.clear();
+    if (!map.passable(start.row, start.col) || !map.passable(goal.row, goal.col)) return NO_PATH;
+
+    int cost = search(start, goal);
+    if (cost != NO_PATH) {
+        waypoints.push_back({start.row, start.col, 0});
+        for (auto node = route.rbegin(); node != route.rend(); ++node) {
+            waypoints.push_back({nodeCell[*node] / map.cols(), nodeCell[*node] % map.cols(), nodeCost[*node]});
+        }
+        waypoints.push_back({goal.row, goal.col, cost});
+    }
+    resetSearch();
+    return cost;
+}
+
+int HierarchicalPathfinder::findPath(const Cell& start, const Cell& goal, std::vector<Cell>& path) {
+    path.clear();
+    if (!map.passable(start.row, start.col) || !map.passable(goal.row, goal.col)) return NO_PATH;
+
+    int cost = search(start, goal);
+    if (cost != NO_PATH) {
+        int current = map.index(start.row, start.col);
+        path.push_back({start.row, start.col, 0});
+
+        // Hops inside a cluster are refined by a local search, crossings are a single step
+        auto hop = [&](int next) {
+            int cluster = clusterOf(current / map.cols(), current % map.cols());
+            if (cluster == clusterOf(next / map.cols(), next % map.cols())) {
+                appendLocal(clusters[cluster], current, next, path);
+            } else {
+                path.push_back({next / map.cols(), next % map.cols(), 0});
+            }
+            current = next;
+        };
+        for (auto node = route.rbegin(); node != route.rend(); ++node) hop(nodeCell[*node]);
+        hop(map.index(goal.row, goal.col));
+        accumulateCosts(map, path);
+    }
+    resetSearch();
+    return cost;
+}
+
+void HierarchicalPathfinder::appendLocal(const Cluster& cluster, int from, int to, std::vector<Cell>& path) {
+    if (from == to) return;
+    localSearch(cluster, from, false);
+
+    std::size_t first = path.size();
+    for (int slot = cellSlot(cluster, to); localParent[slot] >= 0; slot = localParent[slot]) {
+        path.push_back({cluster.top + slot / size, cluster.left + slot % size, 0});
+    }
+    std::reverse(path.begin() + static_cast<std::ptrdiff_t>(first), path.end());
+}
+
+void HierarchicalPathfinder::accumulateCosts(const GridMap& map, std::vector<Cell>& path) {
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        bool diagonal = path[i].row != path[i - 1].row && path[i].col != path[i - 1].col;
+        int step = diagonal ? Pathfinder::DIAGONAL_COST : Pathfinder::STRAIGHT_COST;
+        path[i].cost = path[i - 1].cost + step * map.cost(path[i].row, path[i].col);
+    }
+}
@@ -0,0 +1,143 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_HIERARCHICALPATHFINDER_H
+#define PROJECT_ESPRIT_MODEL_C_HIERARCHICALPATHFINDER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Pathfinder.h"
+#include "../data_structures/BucketQueue.h"
+
+// Hierarchical pathfinding (HPA*) over a GridMap, for long routes across large maps.
+// The map is cut into square clusters. Wherever two neighbouring clusters share an open stretch of
+// border, portal cells are placed on both sides (one in the middle of a short stretch, one at each
+// end of a long one, plus the cheapest crossing of every 8 cells where crossing costs vary). Each
+// cluster caches the cheapest in-cluster cost between every pair of its portals, so a query only
+// searches the start and goal clusters cell by cell and runs A* over the small portal graph in
+// between. Costs follow Pathfinder (10/14 per step times the entered cell's cost, no corner cutting).
+// Routes are not always optimal. With 32 x 32 clusters, long routes on a 512 x 512 map come out
+// about 2% above the best cost on uniform terrain (6% worst) and about 3% above on random costs 1-5
+// (7% worst); short hops across a border can detour through a portal further off. Weighted terrain
+// pays for that with about 5x the portals of a uniform map, and the cost tables are built once up
+// front: on 4096 x 4096 that takes about 6 s uniform, 35 s weighted, and close to a minute when
+// scattered walls break the borders into many short stretches.
+// After changing map costs, report the cells with cellChanged(): the next query rescans only the
+// borders of those clusters and recomputes only the cost tables that changed. Searches run on
+// BucketQueue since every cost is a small integer.
+class HierarchicalPathfinder {
+public:
+    static constexpr int NO_PATH = Pathfinder::NO_PATH;
+
+    explicit HierarchicalPathfinder(const GridMap& map, int clusterSize = 32);
+
+    // Cheapest route found from `start` to `goal`. On success `path` holds every cell from start to
+    // goal with its cumulative cost and the total cost is returned; otherwise `path` is empty and
+    // NO_PATH is returned.
+    int findPath(const Cell& start, const Cell& goal, std::vector<Cell>& path);
+
+    // Same search without refinement: `waypoints` holds start, the portals crossed, and goal, each
+    // with its cumulative cost. Consecutive waypoints can be refined later with a Pathfinder.
+    int findWaypoints(const Cell& start, const Cell& goal, std::vector<Cell>& waypoints);
+
+    // Mark the cluster holding a cell whose cost changed; its caches are rebuilt on the next query
+    void cellChanged(int row, int col);
+
+    // Bring every cache up to date now instead of on the next query
+    void refresh();
+
+    int clusterSize() const { return size; }
+    std::size_t portalCount() const { return nodeCell.size(); }
+
+    // Clusters whose cost tables were recomputed by the last refresh
+    std::size_t rebuiltClusters() const { return rebuilt; }
+
+private:
+    struct QueuedNode {
+        int node;
+        int cost; // Estimated total cost through the node
+    };
+
+    using OpenSet = BucketQueue<Cell>;
+    using NodeQueue = BucketQueue<QueuedNode>;
+    static constexpr int UNREACHED = INT32_MAX;
+    static constexpr int LONG_BORDER = 6;   // Open stretches at least this long get a portal at each end
+    static constexpr int PORTAL_WINDOW = 8; // Uneven long stretches also get one per this many cells
+
+    struct Cluster {
+        int top, left, bottom, right;  // Cell bounds, bottom/right exclusive
+        std::vector<int> portals;      // Sorted map indices of the portal cells inside this cluster
+        std::vector<int> costs;        // costs[i * k + j]: cheapest in-cluster route from portal i to j
+        bool dirty = true;             // Costs changed (or no cost table yet)
+    };
+
+    struct Crossing {
+        int to;   // Portal node on the other side of the border
+        int cost; // One straight step into `to`
+    };
+
+    const GridMap& map;
+    int size;
+    int clusterRows;
+    int clusterCols;
+    std::vector<Cluster> clusters;
+    std::vector<int> dirtyClusters;
+    bool built = false;
+    std::size_t rebuilt = 0;
+
+    // Border 2c runs between cluster c and its right neighbour, border 2c + 1 between c and the
+    // cluster below. Each caches its facing portal cell pairs (inside c, inside the neighbour).
+    std::vector<std::vector<std::pair<int, int>>> borders;
+    std::vector<std::pair<int, int>> rescanned; // Scratch list for an updated border
+
+    // Abstract graph: node n is portal (n - firstNode[c]) of cluster c
+    std::vector<int> firstNode;      // Per cluster, plus a final end marker
+    std::vector<int> nodeCell;       // Map index of each node
+    std::vector<int> nodeCluster;
+    std::vector<int> crossingStart;  // CSR offsets into crossings, one past the last node at the end
+    std::vector<Crossing> crossings;
+    std::vector<std::vector<int>> pendingPortals; // Scratch lists used while rebuilding the graph
+
+    // Bounded search inside one cluster, reusing buffers sized for a full cluster
+    std::vector<int> localCost;
+    std::vector<int> localParent;
+    OpenSet localOpen;
+
+    // Abstract search buffers, reset through the touched list
+    std::vector<int> nodeCost;
+    std::vector<int> nodeParent;
+    std::vector<char> nodeClosed;
+    std::vector<int> touched;
+    NodeQueue abstractOpen;
+    std::vector<int> startCosts; // Cost from start to each portal of the start cluster
+    std::vector<int> goalCosts;  // Cost from each portal of the goal cluster to goal
+    std::vector<int> route;      // Nodes of the last abstract route, goal side first
+
+    int clusterOf(int row, int col) const { return (row / size) * clusterCols + col / size; }
+    int portalSlot(const Cluster& cluster, int mapIndex) const;
+    int cellSlot(const Cluster& cluster, int mapIndex) const;
+
+    int neighbourAcross(int border) const;
+    void scanBorder(int border, std::vector<std::pair<int, int>>& portals) const;
+    void buildGraph();
+    void updateCrossingCosts(int cluster);
+    void computeCosts(Cluster& cluster);
+
+    // Dijkstra from `source` over the cells of `cluster`. Forward fills localCost with the cost from
+    // source; reverse fills it with the cost to source, which is different because entering a cell
+    // is what costs.
+    void localSearch(const Cluster& cluster, int source, bool reverse);
+
+    // Runs the abstract search and returns the total cost or NO_PATH. `route` is left empty when the
+    // best route stays inside the shared cluster of start and goal (which wins ties).
+    int search(const Cell& start, const Cell& goal);
+    void resetSearch();
+
+    // Append the cells after `from` up to `to` found by a local search from `from`
+    void appendLocal(const Cluster& cluster, int from, int to, std::vector<Cell>& path);
+    static void accumulateCosts(const GridMap& map, std::vector<Cell>& path);
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_HIERARCHICALPATHFINDER_H
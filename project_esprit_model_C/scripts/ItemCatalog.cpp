@@ -0,0 +1,304 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#include "ItemCatalog.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "ItemLoader.h"
+
+namespace {
+    constexpr char MAGIC[8] = {'E', 'S', 'P', 'R', 'I', 'T', 'I', 'C'};
+    constexpr std::uint32_t ORDER_MARK = 0x01020304; // Reads back differently on a machine of the other endianness
+
+    enum Section {
+        Prices, MarketValues, Codes, VendorIds, StatusIds, TagBits,
+        NameOffsets, VendorOffsets, StatusOffsets, TagOffsets, Strings, CodeIndex,
+        SECTION_COUNT
+    };
+
+    struct SectionEntry {
+        std::uint64_t offset;
+        std::uint64_t bytes;
+    };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint64_t items;
+        std::uint64_t tagWords;
+        std::uint64_t vendors;
+        std::uint64_t statuses;
+        std::uint64_t tags;
+        SectionEntry sections[SECTION_COUNT];
+    };
+    static_assert(sizeof(Header) % 8 == 0, "Sections after the header must stay 8-byte aligned");
+
+    std::uint64_t alignUp(std::uint64_t value) {
+        return (value + 7) & ~std::uint64_t(7);
+    }
+
+    [[noreturn]] void invalid(const std::string& filePath, const char* problem) {
+        throw std::runtime_error("Invalid item catalog " + filePath + ": " + problem);
+    }
+
+    // A dictionary as its offsets into the string heap (starting at `base`) and the bytes it adds
+    void appendDictionary(const StringDictionary& dictionary, std::uint64_t& base, std::vector<std::uint64_t>& offsets,
+                          std::string& heap) {
+        offsets.push_back(base);
+        for (std::uint32_t id = 0; id < dictionary.size(); ++id) {
+            heap += dictionary[id];
+            base += dictionary[id].size();
+            offsets.push_back(base);
+        }
+    }
+}
+
+void ItemCatalog::write(const ItemStore& store, const std::string& filePath) {
+    std::size_t items = store.size();
+    if (items > UINT32_MAX) throw std::length_error("Item catalogs hold at most 2^32 - 1 items");
+
+    // Strings: the name arena, then the three dictionaries
+    std::string_view names = store.nameArena();
+    std::string dictionaryStrings;
+    std::vector<std::uint64_t> vendorOffsets;
+    std::vector<std::uint64_t> statusOffsets;
+    std::vector<std::uint64_t> tagOffsets;
+    std::uint64_t base = names.size();
+    appendDictionary(store.vendorDictionary(), base, vendorOffsets, dictionaryStrings);
+    appendDictionary(store.statusDictionary(), base, statusOffsets, dictionaryStrings);
+    appendDictionary(store.tagDictionary(), base, tagOffsets, dictionaryStrings);
+
+    std::vector<CodeEntry> codeIndex(items);
+    for (std::size_t item = 0; item < items; ++item) {
+        codeIndex[item] = {store.code(item), static_cast<std::uint32_t>(item)};
+    }
+    std::sort(codeIndex.begin(), codeIndex.end(), [](const CodeEntry& a, const CodeEntry& b) {
+        return a.code != b.code ? a.code < b.code : a.item < b.item;
+    });
+
+    // Lay the sections out back to back after the header
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = ORDER_MARK;
+    header.items = items;
+    header.tagWords = store.tagWords();
+    header.vendors = store.vendorDictionary().size();
+    header.statuses = store.statusDictionary().size();
+    header.tags = store.tagDictionary().size();
+
+    std::span<const char> payloads[SECTION_COUNT];
+    auto bytesOf = [](auto span) { return std::as_bytes(span); };
+    auto asChars = [](std::span<const std::byte> bytes) {
+        return std::span<const char>(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    };
+    payloads[Prices] = asChars(bytesOf(store.priceColumn()));
+    payloads[MarketValues] = asChars(bytesOf(store.marketValueColumn()));
+    payloads[Codes] = asChars(bytesOf(store.codeColumn()));
+    payloads[VendorIds] = asChars(bytesOf(store.vendorColumn()));
+    payloads[StatusIds] = asChars(bytesOf(store.statusColumn()));
+    payloads[TagBits] = asChars(bytesOf(store.tagColumn()));
+    payloads[NameOffsets] = asChars(bytesOf(store.nameOffsetColumn()));
+    payloads[VendorOffsets] = asChars(bytesOf(std::span<const std::uint64_t>(vendorOffsets)));
+    payloads[StatusOffsets] = asChars(bytesOf(std::span<const std::uint64_t>(statusOffsets)));
+    payloads[TagOffsets] = asChars(bytesOf(std::span<const std::uint64_t>(tagOffsets)));
+    payloads[CodeIndex] = asChars(bytesOf(std::span<const CodeEntry>(codeIndex)));
+
+    std::uint64_t offset = sizeof(Header);
+    for (int section = 0; section < SECTION_COUNT; ++section) {
+        std::uint64_t bytes = section == Strings ? names.size() + dictionaryStrings.size() : payloads[section].size();
+        header.sections[section] = {offset, bytes};
+        offset = alignUp(offset + bytes);
+    }
+
+    // Written next to the target and renamed over it, so a catalog mapped elsewhere never sees a partial file
+    std::string temporaryPath = filePath + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) throw std::runtime_error("Could not create file: " + temporaryPath);
+
+        const char padding[8] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        for (int section = 0; section < SECTION_COUNT; ++section) {
+            if (section == Strings) {
+                out.write(names.data(), static_cast<std::streamsize>(names.size()));
+                out.write(dictionaryStrings.data(), static_cast<std::streamsize>(dictionaryStrings.size()));
+            } else {
+                out.write(payloads[section].data(), static_cast<std::streamsize>(payloads[section].size()));
+            }
+            std::uint64_t end = header.sections[section].offset + header.sections[section].bytes;
+            out.write(padding, static_cast<std::streamsize>(alignUp(end) - end));
+        }
+        // Closing flushes the last buffer, which can fail too, so the stream is checked only afterwards
+        out.close();
+        if (!out) {
+            std::error_code ignored;
+            std::filesystem::remove(temporaryPath, ignored);
+            throw std::runtime_error("Could not write file: " + temporaryPath);
+        }
+    }
+    std::filesystem::rename(temporaryPath, filePath);
+}
+// Complexity: O(n log n) for the code index, plus the size of the store
+
+void ItemCatalog::convert(const std::string& textPath, const std::string& catalogPath) {
+    ItemStore store;
+    loadItemsParallel(textPath, store);
+    write(store, catalogPath);
+}
+
+// Only the header, the section table and the dictionaries are read here; the columns stay on disk
+// until something touches them
+ItemCatalog::ItemCatalog(const std::string& filePath) : file(filePath) {
+    Header header{};
+    if (file.size() < sizeof(Header)) invalid(filePath, "too short for a header");
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) invalid(filePath, "wrong magic");
+    if (header.byteOrder != ORDER_MARK) invalid(filePath, "written on a machine of the other byte order");
+    if (header.version != VERSION) invalid(filePath, "unsupported version");
+    // Each count alone is bounded by the file size, which keeps every section size below from wrapping
+    // except the tag matrix: items and tagWords can both be that large, and a forged pair can make
+    // items * tagWords * 8 wrap to any section size. Its bound is therefore checked by division.
+    if (header.items > file.size() || header.vendors > file.size() || header.statuses > file.size() ||
+        header.tags > file.size() || header.tagWords > file.size()) {
+        invalid(filePath, "counts larger than the file");
+    }
+    if (header.tagWords == 0 || header.tagWords < (header.tags + 63) / 64) invalid(filePath, "bad tag width");
+    if (header.tagWords > file.size() / 8 / std::max<std::uint64_t>(header.items, 1)) {
+        invalid(filePath, "tag matrix larger than the file");
+    }
+
+    // Every section must lie inside the file, aligned, and hold exactly what the counts promise
+    const std::uint64_t expected[SECTION_COUNT] = {
+        header.items * 4, header.items * 4, header.items * 4, header.items * 4, header.items,
+        header.items * header.tagWords * 8, (header.items + 1) * 8, (header.vendors + 1) * 8,
+        (header.statuses + 1) * 8, (header.tags + 1) * 8, header.sections[Strings].bytes,
+        header.items * sizeof(CodeEntry)};
+    for (int section = 0; section < SECTION_COUNT; ++section) {
+        const SectionEntry& entry = header.sections[section];
+        if (entry.offset % 8 != 0 || entry.offset > file.size() || entry.bytes > file.size() - entry.offset ||
+            entry.bytes != expected[section]) {
+            invalid(filePath, "section out of bounds");
+        }
+    }
+
+    auto column = [&]<typename T>(Section section, std::span<const T>& target) {
+        const SectionEntry& entry = header.sections[section];
+        target = std::span<const T>(reinterpret_cast<const T*>(file.data() + entry.offset), entry.bytes / sizeof(T));
+    };
+    items = static_cast<std::size_t>(header.items);
+    words = static_cast<std::size_t>(header.tagWords);
+    column(Prices, prices);
+    column(MarketValues, marketValues);
+    column(Codes, codes);
+    column(VendorIds, vendorIds);
+    column(StatusIds, statusIds);
+    column(TagBits, tagBits);
+    column(NameOffsets, nameOffsets);
+    column(VendorOffsets, vendorOffsets);
+    column(StatusOffsets, statusOffsets);
+    column(TagOffsets, tagOffsets);
+    column(CodeIndex, codeIndex);
+    strings = std::string_view(file.data() + header.sections[Strings].offset, header.sections[Strings].bytes);
+
+    for (auto offsets : {vendorOffsets, statusOffsets, tagOffsets}) {
+        if (!std::is_sorted(offsets.begin(), offsets.end()) || offsets.back() > strings.size()) {
+            invalid(filePath, "bad dictionary");
+        }
+    }
+    if (nameOffsets.front() > nameOffsets.back() || nameOffsets.back() > strings.size()) invalid(filePath, "bad names");
+}
+// Complexity: O(dictionary sizes)
+
+void ItemCatalog::corrupt(const char* problem) {
+    throw std::runtime_error(std::string("Corrupt item catalog: ") + problem);
+}
+
+std::string_view ItemCatalog::name(std::size_t item) const {
+    std::uint64_t begin = nameOffsets[item];
+    std::uint64_t end = nameOffsets[item + 1];
+    if (begin > end || end > strings.size()) corrupt("name offsets out of range");
+    return strings.substr(begin, end - begin);
+}
+
+// A bit at or above tagCount() (possible when tagWords * 64 exceeds the tag count) is reported by
+// tagName() as corrupt
+std::vector<std::string_view> ItemCatalog::tags(std::size_t item) const {
+    std::vector<std::string_view> result;
+    for (std::size_t word = 0; word < words; ++word) {
+        for (std::uint64_t bits = tagBits[item * words + word]; bits; bits &= bits - 1) {
+            result.push_back(tagName(static_cast<std::uint32_t>(word * 64 + std::countr_zero(bits))));
+        }
+    }
+    return result;
+}
+
+bool ItemCatalog::hasTag(std::size_t item, std::string_view tag) const {
+    std::uint32_t id = dictionaryId(tagOffsets, tag);
+    return id != ItemStore::NO_ID && ((tagBits[item * words + id / 64] >> (id % 64)) & 1);
+}
+
+Item ItemCatalog::toItem(std::size_t item) const {
+    std::vector<std::string> tagList;
+    for (std::string_view tag : tags(item)) tagList.emplace_back(tag);
+    return Item(std::string(name(item)), prices[item], marketValues[item], tagList, std::string(vendor(item)),
+                codes[item], std::string(status(item)));
+}
+
+std::size_t ItemCatalog::find(std::int32_t code) const {
+    auto it = std::lower_bound(codeIndex.begin(), codeIndex.end(), code,
+                               [](const CodeEntry& entry, std::int32_t value) { return entry.code < value; });
+    if (it == codeIndex.end() || it->code != code) return NO_ITEM;
+    if (it->item >= items) corrupt("code index entry out of range");
+    return it->item;
+}
+// Complexity: O(log n)
+
+// Dictionaries are small (vendors, statuses, tags), so a scan is enough
+std::uint32_t ItemCatalog::dictionaryId(std::span<const std::uint64_t> offsets, std::string_view value) const {
+    for (std::uint32_t id = 0; id + 1 < offsets.size(); ++id) {
+        if (dictionaryString(offsets, id) == value) return id;
+    }
+    return ItemStore::NO_ID;
+}
+// Complexity: O(dictionary bytes)
+
+void ItemCatalog::priceBetween(std::int32_t low, std::int32_t high, ItemSelection& out) const {
+    ItemStore::between(prices, low, high, out);
+}
+
+void ItemCatalog::marketValueBetween(std::int32_t low, std::int32_t high, ItemSelection& out) const {
+    ItemStore::between(marketValues, low, high, out);
+}
+
+void ItemCatalog::withVendor(std::string_view vendor, ItemSelection& out) const {
+    ItemStore::equalTo(vendorIds, dictionaryId(vendorOffsets, vendor), out); // NO_ID matches nothing
+}
+
+void ItemCatalog::withStatus(std::string_view status, ItemSelection& out) const {
+    std::uint32_t id = dictionaryId(statusOffsets, status);
+    if (id == ItemStore::NO_ID) {
+        out.clear(items);
+        return;
+    }
+    ItemStore::equalTo(statusIds, static_cast<std::uint8_t>(id), out);
+}
+
+void ItemCatalog::withTags(std::span<const std::string_view> tags, ItemSelection& out) const {
+    std::vector<std::uint64_t> mask(words, 0);
+    for (std::string_view tag : tags) {
+        std::uint32_t id = dictionaryId(tagOffsets, tag);
+        if (id == ItemStore::NO_ID) {
+            out.clear(items);
+            return;
+        }
+        mask[id / 64] |= std::uint64_t(1) << (id % 64);
+    }
+    ItemStore::containsAll(tagBits, words, mask, out);
+}
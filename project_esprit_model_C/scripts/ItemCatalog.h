@@ -0,0 +1,116 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_ITEMCATALOG_H
+#define PROJECT_ESPRIT_MODEL_C_ITEMCATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ItemStore.h"
+#include "MappedFile.h"
+
+// Read-only item catalog backed by a memory-mapped binary file, so startup costs one mmap and a
+// header check no matter how many items there are. The file holds an ItemStore's columns exactly
+// as they sit in memory, and the accessors and filters read straight from the mapping.
+//
+// File layout (version 1, little-endian, every section 8-byte aligned):
+//   Header       magic "ESPRITIC", version, byte order mark, counts, then a table of
+//                (offset, bytes) for each section below
+//   Prices, MarketValues, Codes           int32[items]
+//   VendorIds                             uint32[items]
+//   StatusIds                             uint8[items]
+//   TagBits                               uint64[items * tagWords], item-major like ItemStore
+//   NameOffsets                           uint64[items + 1]     into Strings
+//   VendorOffsets, StatusOffsets, TagOffsets  uint64[count + 1] into Strings (the dictionaries)
+//   Strings                               names, then vendor, status and tag strings, unterminated
+//   CodeIndex                             {int32 code, uint32 item}[items] sorted by code, then item
+// Opening checks the header, every section's bounds and the dictionaries. Per-item vendor and status
+// ids, tag bits, name offsets and code index entries are checked when an accessor reads them, so
+// opening stays O(dictionaries); a corrupt one throws runtime_error instead of reading out of bounds.
+class ItemCatalog {
+public:
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t NO_ITEM = SIZE_MAX;
+
+    // Map `filePath`; throws runtime_error if it is not a valid version 1 catalog
+    explicit ItemCatalog(const std::string& filePath);
+
+    // Serialize `store` to `filePath`, replacing it
+    static void write(const ItemStore& store, const std::string& filePath);
+
+    // Parse a text catalog (sources/items.txt format) and write it as a binary catalog
+    static void convert(const std::string& textPath, const std::string& catalogPath);
+
+    std::size_t size() const { return items; }
+    bool empty() const { return items == 0; }
+
+    // Fields of item i
+    std::string_view name(std::size_t item) const;
+    std::int32_t price(std::size_t item) const { return prices[item]; }
+    std::int32_t marketValue(std::size_t item) const { return marketValues[item]; }
+    std::int32_t code(std::size_t item) const { return codes[item]; }
+    std::string_view vendor(std::size_t item) const { return dictionaryString(vendorOffsets, vendorIds[item]); }
+    std::string_view status(std::size_t item) const { return dictionaryString(statusOffsets, statusIds[item]); }
+    std::vector<std::string_view> tags(std::size_t item) const;
+    bool hasTag(std::size_t item, std::string_view tag) const;
+    Item toItem(std::size_t item) const;
+
+    // Item with this code (the first one if several share it), or NO_ITEM
+    std::size_t find(std::int32_t code) const;
+
+    // Filters, as in ItemStore
+    void priceBetween(std::int32_t low, std::int32_t high, ItemSelection& out) const;
+    void marketValueBetween(std::int32_t low, std::int32_t high, ItemSelection& out) const;
+    void withVendor(std::string_view vendor, ItemSelection& out) const;
+    void withStatus(std::string_view status, ItemSelection& out) const;
+    void withTags(std::span<const std::string_view> tags, ItemSelection& out) const;
+
+    std::span<const std::int32_t> priceColumn() const { return prices; }
+    std::span<const std::int32_t> marketValueColumn() const { return marketValues; }
+    std::span<const std::int32_t> codeColumn() const { return codes; }
+    std::span<const std::uint64_t> tagColumn() const { return tagBits; }
+    std::size_t tagWords() const { return words; }
+    std::size_t tagCount() const { return tagOffsets.size() - 1; }
+    std::string_view tagName(std::uint32_t tag) const { return dictionaryString(tagOffsets, tag); }
+
+private:
+    struct CodeEntry {
+        std::int32_t code;
+        std::uint32_t item;
+    };
+
+    MappedFile file;
+    std::size_t items = 0;
+    std::size_t words = 1;
+    std::span<const std::int32_t> prices;
+    std::span<const std::int32_t> marketValues;
+    std::span<const std::int32_t> codes;
+    std::span<const std::uint32_t> vendorIds;
+    std::span<const std::uint8_t> statusIds;
+    std::span<const std::uint64_t> tagBits;
+    std::span<const std::uint64_t> nameOffsets;
+    std::span<const std::uint64_t> vendorOffsets;
+    std::span<const std::uint64_t> statusOffsets;
+    std::span<const std::uint64_t> tagOffsets;
+    std::string_view strings;
+    std::span<const CodeEntry> codeIndex;
+
+    // Opening checked that every dictionary's offsets are sorted and inside `strings`, so only the id
+    // needs a bound
+    std::string_view dictionaryString(std::span<const std::uint64_t> offsets, std::uint32_t id) const {
+        if (id >= offsets.size() - 1) corrupt("dictionary id out of range");
+        return strings.substr(offsets[id], offsets[id + 1] - offsets[id]);
+    }
+
+    [[noreturn]] static void corrupt(const char* problem);
+
+    // Id of `value` in a dictionary section, or ItemStore::NO_ID
+    std::uint32_t dictionaryId(std::span<const std::uint64_t> offsets, std::string_view value) const;
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_ITEMCATALOG_H
@@ -0,0 +1,165 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#include "ItemLoader.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "MappedFile.h"
+
+namespace {
+    constexpr std::size_t FIELDS = 7;
+    constexpr std::size_t MIN_CHUNK = 1 << 16; // Smallest chunk worth a thread, in bytes
+
+    // The first malformed row of a text
+    struct ParseFailure {
+        const char* problem = nullptr;
+        std::size_t line = 0;
+        std::string_view row;
+    };
+
+    [[noreturn]] void fail(const ParseFailure& failure) {
+        throw std::runtime_error(std::string(failure.problem) + " at line " + std::to_string(failure.line) + ": " +
+                                 std::string(failure.row));
+    }
+
+    bool parseNumber(std::string_view field, std::int32_t& value) {
+        auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+        return error == std::errc() && end == field.data() + field.size();
+    }
+
+    // Split `line` on commas into its first FIELDS fields; false if it has fewer
+    bool splitFields(std::string_view line, std::string_view (&fields)[FIELDS]) {
+        const char* cursor = line.data();
+        const char* end = cursor + line.size();
+        for (std::size_t field = 0; field < FIELDS; ++field) {
+            auto* comma = static_cast<const char*>(std::memchr(cursor, ',', static_cast<std::size_t>(end - cursor)));
+            const char* fieldEnd = comma ? comma : end;
+            fields[field] = std::string_view(cursor, static_cast<std::size_t>(fieldEnd - cursor));
+            if (!comma) return field == FIELDS - 1;
+            cursor = comma + 1;
+        }
+        return true;
+    }
+
+    // Append the rows of `text` to `store`, stopping at the first malformed one (false, with `failure` set)
+    bool parseRows(std::string_view text, ItemStore& store, std::size_t firstLine, ParseFailure& failure) {
+        std::string_view fields[FIELDS];
+        std::vector<std::string_view> tags;
+        std::int32_t numbers[3];
+        std::size_t line = firstLine;
+
+        const char* cursor = text.data();
+        const char* end = cursor + text.size();
+        for (; cursor < end; ++line) {
+            auto* newline = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+            const char* lineEnd = newline ? newline : end;
+            std::string_view row(cursor, static_cast<std::size_t>(lineEnd - cursor));
+            cursor = lineEnd + 1;
+
+            if (!row.empty() && row.back() == '\r') row.remove_suffix(1);
+            if (row.empty()) continue;
+            if (!splitFields(row, fields)) {
+                failure = {"Invalid line format", line, row};
+                return false;
+            }
+            if (!parseNumber(fields[1], numbers[0]) || !parseNumber(fields[2], numbers[1]) ||
+                !parseNumber(fields[5], numbers[2])) {
+                failure = {"Invalid number", line, row};
+                return false;
+            }
+
+            tags.clear();
+            std::string_view tagField = fields[3];
+            while (!tagField.empty()) {
+                std::size_t bar = tagField.find('|');
+                std::string_view tag = tagField.substr(0, bar);
+                if (!tag.empty()) tags.push_back(tag);
+                tagField.remove_prefix(bar == std::string_view::npos ? tagField.size() : bar + 1);
+            }
+
+            store.add(fields[0], numbers[0], numbers[1], tags, fields[4], numbers[2], fields[6]);
+        }
+        return true;
+    }
+}
+
+void parseItems(std::string_view text, ItemStore& store, std::size_t firstLine) {
+    ParseFailure failure;
+    if (!parseRows(text, store, firstLine, failure)) fail(failure);
+}
+// Complexity: O(text length)
+
+// Each chunk runs parseRows into its own store with lines counted from 1. Only when a chunk fails are
+// the newlines of the chunks before it counted, to turn its line number into one for the whole text.
+void parseItemsParallel(std::string_view text, ItemStore& store, unsigned threads) {
+    if (text.empty()) return;
+    std::size_t chunks = std::clamp<std::size_t>(text.size() / MIN_CHUNK, 1, std::max(1u, threads));
+
+    // Cut points just past the first newline at or after each even split
+    std::vector<std::string_view> pieces;
+    std::size_t begin = 0;
+    for (std::size_t chunk = 1; chunk <= chunks && begin < text.size(); ++chunk) {
+        std::size_t end = text.size();
+        if (chunk < chunks) {
+            std::size_t newline = text.find('\n', std::max(begin, text.size() / chunks * chunk));
+            end = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        pieces.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+
+    std::vector<ItemStore> parts(pieces.size());
+    std::vector<ParseFailure> failures(pieces.size());
+    std::vector<char> parsed(pieces.size(), 0);
+    std::vector<std::exception_ptr> errors(pieces.size());
+    auto work = [&](std::size_t piece) {
+        try {
+            parsed[piece] = parseRows(pieces[piece], parts[piece], 1, failures[piece]);
+        } catch (...) {
+            errors[piece] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(pieces.size() - 1);
+    for (std::size_t piece = 1; piece < pieces.size(); ++piece) workers.emplace_back(work, piece);
+    work(0);
+    for (auto& worker : workers) worker.join();
+
+    // Report the first problem in text order, as a sequential parse would
+    std::size_t linesBefore = 0;
+    for (std::size_t piece = 0; piece < pieces.size(); ++piece) {
+        if (errors[piece]) std::rethrow_exception(errors[piece]);
+        if (!parsed[piece]) {
+            failures[piece].line += linesBefore;
+            fail(failures[piece]);
+        }
+        linesBefore += static_cast<std::size_t>(std::count(pieces[piece].begin(), pieces[piece].end(), '\n'));
+    }
+
+    for (ItemStore& part : parts) {
+        if (store.empty()) {
+            store = std::move(part);
+        } else {
+            store.append(part);
+        }
+    }
+}
+// Complexity: O(text length / threads + items)
+
+void loadItems(const std::string& filePath, ItemStore& store) {
+    MappedFile file(filePath);
+    parseItems(file.text(), store);
+}
+
+void loadItemsParallel(const std::string& filePath, ItemStore& store, unsigned threads) {
+    MappedFile file(filePath);
+    parseItemsParallel(file.text(), store, threads);
+}
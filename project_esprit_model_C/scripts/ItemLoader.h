@@ -0,0 +1,37 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_ITEMLOADER_H
+#define PROJECT_ESPRIT_MODEL_C_ITEMLOADER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "ItemStore.h"
+
+// Fast loading of item catalogs in the sources/items.txt format, one item per line:
+//     name,price,market_value,tag1|tag2|tag3,vendor_name,code,status
+// Unlike parseItemsFromFile, lines are tokenized in place: fields are string_views into the text,
+// numbers are read with std::from_chars, and the only copies made are the ones ItemStore keeps.
+// Empty lines and a trailing '\r' are ignored, fields after the seventh are skipped (as
+// parseItemsFromFile does), and so are empty tags. Numbers must fill their whole field.
+
+// Append every item of `text` to `store`. A malformed line throws runtime_error naming its line
+// number, counted from `firstLine`; items before it stay in the store.
+void parseItems(std::string_view text, ItemStore& store, std::size_t firstLine = 1);
+
+// Same as parseItems, split across `threads`: the text is cut into newline-aligned chunks (at least
+// 64 KB each), every chunk is parsed into its own ItemStore on its own thread, and the parts are
+// appended to `store` in text order. The first malformed line in text order is reported with its
+// line number in the whole text, and then nothing is added to `store`.
+void parseItemsParallel(std::string_view text, ItemStore& store,
+                        unsigned threads = std::thread::hardware_concurrency());
+
+// Memory-map `filePath` and parse it into `store`
+void loadItems(const std::string& filePath, ItemStore& store);
+void loadItemsParallel(const std::string& filePath, ItemStore& store,
+                       unsigned threads = std::thread::hardware_concurrency());
+
+#endif //PROJECT_ESPRIT_MODEL_C_ITEMLOADER_H
@@ -0,0 +1,329 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#include "ItemStore.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    // Fill `out` with one bit per item, matches(i) deciding item i. Each block of 64 items is first
+    // compared into 64 bytes by a branch-free loop the compiler vectorizes, then every 8 bytes of
+    // 0/1 are gathered into 8 bits with one multiply (bit k of the product's top byte is byte k on
+    // the little-endian targets the game ships on).
+    template <typename Predicate>
+    void pack(std::size_t items, ItemSelection& out, Predicate matches) {
+        out.items = items;
+        out.words.assign((items + 63) / 64, 0);
+
+        std::size_t full = items / 64;
+        std::uint8_t flags[64];
+        for (std::size_t word = 0; word < full; ++word) {
+            std::size_t base = word * 64;
+            for (unsigned item = 0; item < 64; ++item) flags[item] = matches(base + item) ? 1 : 0;
+
+            std::uint64_t bits = 0;
+            for (unsigned byte = 0; byte < 8; ++byte) {
+                std::uint64_t eight;
+                std::memcpy(&eight, flags + byte * 8, 8);
+                bits |= ((eight * 0x0102040810204080ULL) >> 56) << (byte * 8);
+            }
+            out.words[word] = bits;
+        }
+        for (std::size_t item = full * 64; item < items; ++item) {
+            out.words[full] |= std::uint64_t(matches(item)) << (item & 63);
+        }
+    }
+}
+
+std::size_t ItemSelection::count() const {
+    std::size_t total = 0;
+    for (std::uint64_t word : words) total += static_cast<std::size_t>(std::popcount(word));
+    return total;
+}
+
+std::vector<std::size_t> ItemSelection::indices() const {
+    std::vector<std::size_t> result;
+    result.reserve(count());
+    for (std::size_t word = 0; word < words.size(); ++word) {
+        for (std::uint64_t bits = words[word]; bits; bits &= bits - 1) {
+            result.push_back(word * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+        }
+    }
+    return result;
+}
+
+ItemSelection& ItemSelection::operator&=(const ItemSelection& other) {
+    if (other.items != items) throw std::invalid_argument("Selections cover different item counts");
+    for (std::size_t word = 0; word < words.size(); ++word) words[word] &= other.words[word];
+    return *this;
+}
+
+ItemSelection& ItemSelection::operator|=(const ItemSelection& other) {
+    if (other.items != items) throw std::invalid_argument("Selections cover different item counts");
+    for (std::size_t word = 0; word < words.size(); ++word) words[word] |= other.words[word];
+    return *this;
+}
+
+void ItemSelection::invert() {
+    for (std::uint64_t& word : words) word = ~word;
+    if (items & 63) words.back() &= (std::uint64_t(1) << (items & 63)) - 1; // Keep bits past the end clear
+}
+
+void ItemSelection::clear(std::size_t count) {
+    items = count;
+    words.assign((count + 63) / 64, 0);
+}
+
+std::uint32_t StringDictionary::intern(std::string_view value) {
+    auto it = ids.find(value);
+    if (it != ids.end()) return it->second;
+
+    auto id = static_cast<std::uint32_t>(values.size());
+    values.emplace_back(value);
+    ids.emplace(values.back(), id);
+    return id;
+}
+
+std::uint32_t StringDictionary::find(std::string_view value) const {
+    auto it = ids.find(value);
+    return it == ids.end() ? NO_ID : it->second;
+}
+
+void StringDictionary::clear() {
+    values.clear();
+    ids.clear();
+}
+
+std::size_t ItemStore::add(const Item& item) {
+    std::vector<std::string_view> tags(item.getTags().begin(), item.getTags().end());
+    return add(item.getName(), item.getPrice(), item.getMarketValue(), tags, item.getVendorName(), item.getCode(),
+               item.getStatus());
+}
+
+std::size_t ItemStore::add(std::string_view name, std::int32_t price, std::int32_t marketValue,
+                           std::span<const std::string_view> tags, std::string_view vendor, std::int32_t code,
+                           std::string_view status) {
+    // Checked before interning, so a rejected item leaves no orphan status behind
+    if (statuses.find(status) == NO_ID && statuses.size() > UINT8_MAX) {
+        throw std::length_error("ItemStore supports at most 256 distinct statuses");
+    }
+    std::uint32_t statusId = statuses.intern(status);
+
+    std::size_t item = size();
+    tagBits.resize(tagBits.size() + words, 0);
+    for (std::string_view tag : tags) {
+        std::uint32_t id = tagNames.intern(tag);
+        if (id >= words * 64) growTagWords(id + 1);
+        tagBits[item * words + id / 64] |= std::uint64_t(1) << (id % 64);
+    }
+
+    prices.push_back(price);
+    marketValues.push_back(marketValue);
+    codes.push_back(code);
+    vendorIds.push_back(vendors.intern(vendor));
+    statusIds.push_back(static_cast<std::uint8_t>(statusId));
+    names.append(name);
+    nameOffsets.push_back(names.size());
+    return item;
+}
+// Complexity: O(name length + tags) amortized
+
+// Rare: doubles the width, so n items with t tags are re-laid out O(log t) times
+void ItemStore::growTagWords(std::size_t tags) {
+    std::size_t wider = words;
+    while (wider * 64 < tags) wider *= 2;
+
+    std::size_t items = tagBits.size() / words; // Includes the item being added
+    std::vector<std::uint64_t> grown(items * wider, 0);
+    for (std::size_t item = 0; item < items; ++item) {
+        std::copy_n(tagBits.begin() + static_cast<std::ptrdiff_t>(item * words), words,
+                    grown.begin() + static_cast<std::ptrdiff_t>(item * wider));
+    }
+    tagBits = std::move(grown);
+    words = wider;
+}
+// Complexity: O(n * tagWords())
+
+std::size_t ItemStore::append(const ItemStore& other) {
+    std::size_t first = size();
+    std::vector<std::uint32_t> vendorMap(other.vendors.size());
+    std::vector<std::uint8_t> statusMap(other.statuses.size());
+    std::vector<std::uint32_t> tagMap(other.tagNames.size());
+    // Count the new statuses first, so a rejected append leaves this store untouched
+    std::size_t newStatuses = 0;
+    for (std::uint32_t id = 0; id < other.statuses.size(); ++id) {
+        if (statuses.find(other.statuses[id]) == NO_ID) ++newStatuses;
+    }
+    if (statuses.size() + newStatuses > UINT8_MAX + 1) {
+        throw std::length_error("ItemStore supports at most 256 distinct statuses");
+    }
+    for (std::uint32_t id = 0; id < other.statuses.size(); ++id) {
+        statusMap[id] = static_cast<std::uint8_t>(statuses.intern(other.statuses[id]));
+    }
+    for (std::uint32_t id = 0; id < other.vendors.size(); ++id) vendorMap[id] = vendors.intern(other.vendors[id]);
+    bool sameTags = true;
+    for (std::uint32_t id = 0; id < other.tagNames.size(); ++id) {
+        tagMap[id] = tagNames.intern(other.tagNames[id]);
+        sameTags = sameTags && tagMap[id] == id;
+    }
+    if (tagNames.size() > words * 64) growTagWords(tagNames.size());
+
+    prices.insert(prices.end(), other.prices.begin(), other.prices.end());
+    marketValues.insert(marketValues.end(), other.marketValues.begin(), other.marketValues.end());
+    codes.insert(codes.end(), other.codes.begin(), other.codes.end());
+    for (std::uint32_t id : other.vendorIds) vendorIds.push_back(vendorMap[id]);
+    for (std::uint8_t id : other.statusIds) statusIds.push_back(statusMap[id]);
+
+    // Tag bitsets copy word for word when ids line up, e.g. for the first part of a split load
+    tagBits.resize((first + other.size()) * words, 0);
+    for (std::size_t item = 0; item < other.size(); ++item) {
+        const std::uint64_t* source = other.tagBits.data() + item * other.words;
+        std::uint64_t* target = tagBits.data() + (first + item) * words;
+        if (sameTags) {
+            std::copy_n(source, other.words, target);
+            continue;
+        }
+        for (std::size_t word = 0; word < other.words; ++word) {
+            for (std::uint64_t bits = source[word]; bits; bits &= bits - 1) {
+                std::uint32_t id = tagMap[word * 64 + static_cast<std::size_t>(std::countr_zero(bits))];
+                target[id / 64] |= std::uint64_t(1) << (id % 64);
+            }
+        }
+    }
+
+    std::uint64_t shift = names.size();
+    names.append(other.names);
+    for (std::size_t item = 1; item <= other.size(); ++item) nameOffsets.push_back(other.nameOffsets[item] + shift);
+    return first;
+}
+// Complexity: O(other items * tags per item + other dictionaries)
+
+void ItemStore::reserve(std::size_t items, std::size_t nameBytes) {
+    prices.reserve(items);
+    marketValues.reserve(items);
+    codes.reserve(items);
+    vendorIds.reserve(items);
+    statusIds.reserve(items);
+    tagBits.reserve(items * words);
+    nameOffsets.reserve(items + 1);
+    names.reserve(nameBytes);
+}
+
+void ItemStore::clear() {
+    prices.clear();
+    marketValues.clear();
+    codes.clear();
+    vendorIds.clear();
+    statusIds.clear();
+    tagBits.clear();
+    words = 1;
+    names.clear();
+    nameOffsets.assign(1, 0);
+    vendors.clear();
+    statuses.clear();
+    tagNames.clear();
+}
+
+std::string_view ItemStore::name(std::size_t item) const {
+    return std::string_view(names).substr(nameOffsets[item], nameOffsets[item + 1] - nameOffsets[item]);
+}
+
+std::vector<std::string_view> ItemStore::tags(std::size_t item) const {
+    std::vector<std::string_view> result;
+    for (std::size_t word = 0; word < words; ++word) {
+        for (std::uint64_t bits = tagBits[item * words + word]; bits; bits &= bits - 1) {
+            result.emplace_back(tagNames[static_cast<std::uint32_t>(word * 64 + std::countr_zero(bits))]);
+        }
+    }
+    return result;
+}
+
+bool ItemStore::hasTag(std::size_t item, std::string_view tag) const {
+    std::uint32_t id = tagNames.find(tag);
+    return id != NO_ID && ((tagBits[item * words + id / 64] >> (id % 64)) & 1);
+}
+
+Item ItemStore::toItem(std::size_t item) const {
+    std::vector<std::string> tagList;
+    for (std::string_view tag : tags(item)) tagList.emplace_back(tag);
+    return Item(std::string(name(item)), prices[item], marketValues[item], tagList, vendor(item), codes[item],
+                status(item));
+}
+
+void ItemStore::between(std::span<const std::int32_t> column, std::int32_t low, std::int32_t high, ItemSelection& out) {
+    if (low > high) {
+        out.clear(column.size());
+        return;
+    }
+    // One unsigned compare per value: (value - low) wraps past the range for anything below low
+    auto base = static_cast<std::uint32_t>(low);
+    auto range = static_cast<std::uint32_t>(high) - base;
+    const std::int32_t* values = column.data();
+    pack(column.size(), out, [=](std::size_t item) { return static_cast<std::uint32_t>(values[item]) - base <= range; });
+}
+// Complexity: O(n)
+
+void ItemStore::equalTo(std::span<const std::uint32_t> column, std::uint32_t value, ItemSelection& out) {
+    const std::uint32_t* values = column.data();
+    pack(column.size(), out, [=](std::size_t item) { return values[item] == value; });
+}
+// Complexity: O(n)
+
+void ItemStore::equalTo(std::span<const std::uint8_t> column, std::uint8_t value, ItemSelection& out) {
+    const std::uint8_t* values = column.data();
+    pack(column.size(), out, [=](std::size_t item) { return values[item] == value; });
+}
+// Complexity: O(n)
+
+void ItemStore::containsAll(std::span<const std::uint64_t> bits, std::size_t words, std::span<const std::uint64_t> mask,
+                            ItemSelection& out) {
+    const std::uint64_t* row = bits.data();
+    if (words == 1) {
+        std::uint64_t want = mask[0];
+        pack(bits.size(), out, [=](std::size_t item) { return (row[item] & want) == want; });
+        return;
+    }
+    pack(bits.size() / words, out, [&](std::size_t item) {
+        std::uint64_t missing = 0;
+        for (std::size_t word = 0; word < words; ++word) missing |= mask[word] & ~row[item * words + word];
+        return missing == 0;
+    });
+}
+// Complexity: O(n * words)
+
+void ItemStore::priceBetween(std::int32_t low, std::int32_t high, ItemSelection& out) const {
+    between(prices, low, high, out);
+}
+
+void ItemStore::marketValueBetween(std::int32_t low, std::int32_t high, ItemSelection& out) const {
+    between(marketValues, low, high, out);
+}
+
+void ItemStore::withVendor(std::string_view vendor, ItemSelection& out) const {
+    equalTo(std::span<const std::uint32_t>(vendorIds), vendors.find(vendor), out); // NO_ID matches nothing
+}
+
+void ItemStore::withStatus(std::string_view status, ItemSelection& out) const {
+    std::uint32_t id = statuses.find(status);
+    if (id == NO_ID) {
+        out.clear(size());
+        return;
+    }
+    equalTo(std::span<const std::uint8_t>(statusIds), static_cast<std::uint8_t>(id), out);
+}
+
+void ItemStore::withTags(std::span<const std::string_view> tags, ItemSelection& out) const {
+    std::vector<std::uint64_t> mask(words, 0);
+    for (std::string_view tag : tags) {
+        std::uint32_t id = tagNames.find(tag);
+        if (id == NO_ID) {
+            out.clear(size());
+            return;
+        }
+        mask[id / 64] |= std::uint64_t(1) << (id % 64);
+    }
+    containsAll(tagBits, words, mask, out);
+}
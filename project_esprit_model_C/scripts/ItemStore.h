@@ -0,0 +1,154 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_ITEMSTORE_H
+#define PROJECT_ESPRIT_MODEL_C_ITEMSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Item.h"
+
+// One bit per item of an ItemStore, as produced by its filter kernels. Selections over the same store
+// combine with &= / |= a word at a time.
+struct ItemSelection {
+    std::vector<std::uint64_t> words;
+    std::size_t items = 0;
+
+    bool contains(std::size_t item) const { return (words[item >> 6] >> (item & 63)) & 1; }
+
+    // Number of selected items
+    std::size_t count() const;
+
+    // Selected items in increasing order
+    std::vector<std::size_t> indices() const;
+
+    ItemSelection& operator&=(const ItemSelection& other);
+    ItemSelection& operator|=(const ItemSelection& other);
+
+    // Select exactly the items that were not selected
+    void invert();
+
+    // Select none of `items` items
+    void clear(std::size_t items);
+};
+
+// Strings interned to dense ids in order of first appearance
+class StringDictionary {
+public:
+    static constexpr std::uint32_t NO_ID = UINT32_MAX;
+
+    // Id of `value`, adding it if it is new
+    std::uint32_t intern(std::string_view value);
+
+    // Id of `value`, or NO_ID if it was never interned
+    std::uint32_t find(std::string_view value) const;
+
+    const std::string& operator[](std::uint32_t id) const { return values[id]; }
+    std::size_t size() const { return values.size(); }
+    void clear();
+
+private:
+    struct Hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+    };
+
+    std::vector<std::string> values;
+    std::unordered_map<std::string, std::uint32_t, Hash, std::equal_to<>> ids;
+};
+
+// The item catalog as columns instead of a vector<Item>: every field of every item sits in its own
+// contiguous array, so a filter over prices or statuses streams through 4 or 1 bytes per item
+// instead of hopping between heap-allocated strings.
+//  - price, market value and code are int32 columns
+//  - vendor and status are ids into a StringDictionary (uint32 and uint8)
+//  - tags are a bitset per item, tagWords() 64-bit words wide, indexed by tag id
+//  - names are packed back to back in one arena, item i spanning [nameOffsets[i], nameOffsets[i + 1])
+// Filters write an ItemSelection and are branch-free loops over a column, 64 items per output word.
+// Tags are a set: they come back in tag id order and without duplicates.
+class ItemStore {
+public:
+    static constexpr std::uint32_t NO_ID = StringDictionary::NO_ID;
+
+    ItemStore() { nameOffsets.push_back(0); }
+
+    // Append an item and return its index
+    std::size_t add(const Item& item);
+    std::size_t add(std::string_view name, std::int32_t price, std::int32_t marketValue,
+                    std::span<const std::string_view> tags, std::string_view vendor, std::int32_t code,
+                    std::string_view status);
+
+    // Append every item of `other`, translating its vendor, status and tag ids into this store's
+    std::size_t append(const ItemStore& other);
+
+    void reserve(std::size_t items, std::size_t nameBytes = 0);
+    void clear();
+    std::size_t size() const { return prices.size(); }
+    bool empty() const { return prices.empty(); }
+
+    // Fields of item i
+    std::string_view name(std::size_t item) const;
+    std::int32_t price(std::size_t item) const { return prices[item]; }
+    std::int32_t marketValue(std::size_t item) const { return marketValues[item]; }
+    std::int32_t code(std::size_t item) const { return codes[item]; }
+    const std::string& vendor(std::size_t item) const { return vendors[vendorIds[item]]; }
+    const std::string& status(std::size_t item) const { return statuses[statusIds[item]]; }
+    std::vector<std::string_view> tags(std::size_t item) const;
+    bool hasTag(std::size_t item, std::string_view tag) const;
+    Item toItem(std::size_t item) const;
+
+    // Raw columns, for kernels and serialization
+    std::span<const std::int32_t> priceColumn() const { return prices; }
+    std::span<const std::int32_t> marketValueColumn() const { return marketValues; }
+    std::span<const std::int32_t> codeColumn() const { return codes; }
+    std::span<const std::uint32_t> vendorColumn() const { return vendorIds; }
+    std::span<const std::uint8_t> statusColumn() const { return statusIds; }
+    std::span<const std::uint64_t> tagColumn() const { return tagBits; }
+    std::span<const std::uint64_t> nameOffsetColumn() const { return nameOffsets; }
+    std::string_view nameArena() const { return names; }
+    std::size_t tagWords() const { return words; }
+    const StringDictionary& vendorDictionary() const { return vendors; }
+    const StringDictionary& statusDictionary() const { return statuses; }
+    const StringDictionary& tagDictionary() const { return tagNames; }
+
+    // Filters: replace `out` with the matching items
+    void priceBetween(std::int32_t low, std::int32_t high, ItemSelection& out) const;
+    void marketValueBetween(std::int32_t low, std::int32_t high, ItemSelection& out) const;
+    void withVendor(std::string_view vendor, ItemSelection& out) const;
+    void withStatus(std::string_view status, ItemSelection& out) const;
+    void withTags(std::span<const std::string_view> tags, ItemSelection& out) const; // Items having all of them
+
+    // The kernels behind the filters, usable on any column laid out like the store's
+    static void between(std::span<const std::int32_t> column, std::int32_t low, std::int32_t high, ItemSelection& out);
+    static void equalTo(std::span<const std::uint32_t> column, std::uint32_t value, ItemSelection& out);
+    static void equalTo(std::span<const std::uint8_t> column, std::uint8_t value, ItemSelection& out);
+    static void containsAll(std::span<const std::uint64_t> bits, std::size_t words, std::span<const std::uint64_t> mask,
+                            ItemSelection& out);
+
+private:
+    std::vector<std::int32_t> prices;
+    std::vector<std::int32_t> marketValues;
+    std::vector<std::int32_t> codes;
+    std::vector<std::uint32_t> vendorIds;
+    std::vector<std::uint8_t> statusIds;
+    std::vector<std::uint64_t> tagBits;     // words per item, item-major
+    std::size_t words = 1;
+    std::string names;
+    std::vector<std::uint64_t> nameOffsets; // size() + 1 entries
+
+    StringDictionary vendors;
+    StringDictionary statuses;
+    StringDictionary tagNames;
+
+    // Widen every item's tag bitset to hold at least `tags` tags
+    void growTagWords(std::size_t tags);
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_ITEMSTORE_H
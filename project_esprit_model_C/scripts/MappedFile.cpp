@@ -0,0 +1,99 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#include "MappedFile.h"
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filePath) {
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Could not open file: " + filePath);
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw std::runtime_error("Could not read the size of file: " + filePath);
+    }
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    if (length == 0) {
+        CloseHandle(file);
+        return;
+    }
+
+    // The view keeps the file referenced, so both handles can be closed once it exists
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) throw std::runtime_error("Could not map file: " + filePath);
+    begin = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+    if (!begin) throw std::runtime_error("Could not map file: " + filePath);
+}
+
+void MappedFile::unmap() {
+    if (begin) UnmapViewOfFile(begin);
+    begin = nullptr;
+    length = 0;
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filePath) {
+    int file = open(filePath.c_str(), O_RDONLY);
+    if (file < 0) throw std::runtime_error("Could not open file: " + filePath);
+
+    struct stat info{};
+    if (fstat(file, &info) != 0) {
+        close(file);
+        throw std::runtime_error("Could not read the size of file: " + filePath);
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    if (length == 0) {
+        close(file);
+        return;
+    }
+
+    void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); // The mapping keeps the file referenced
+    if (view == MAP_FAILED) throw std::runtime_error("Could not map file: " + filePath);
+    madvise(view, length, MADV_SEQUENTIAL); // Read ahead aggressively, drop pages behind
+    begin = static_cast<const char*>(view);
+}
+
+void MappedFile::unmap() {
+    if (begin) munmap(const_cast<char*>(begin), length);
+    begin = nullptr;
+    length = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+        : begin(std::exchange(other.begin, nullptr)), length(std::exchange(other.length, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        begin = std::exchange(other.begin, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
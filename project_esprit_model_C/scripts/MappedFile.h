@@ -0,0 +1,37 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_MAPPEDFILE_H
+#define PROJECT_ESPRIT_MODEL_C_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// A whole file mapped read-only into memory (mmap on POSIX, CreateFileMapping on Windows). The OS
+// pages it in on first touch and can drop the pages again under pressure, so even files larger
+// than RAM can be scanned without copying them into buffers. Move-only; unmapped on destruction.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filePath); // Throws runtime_error if the file can't be mapped
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return begin; }
+    std::size_t size() const { return length; }
+    std::string_view text() const { return {begin, length}; }
+
+private:
+    const char* begin = nullptr; // Null for an empty file, which can't be mapped
+    std::size_t length = 0;
+
+    void unmap();
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_MAPPEDFILE_H
@@ -0,0 +1,265 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#include "Pathfinder.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+GridMap::GridMap(int rows, int cols, int defaultCost) : rowCount(rows), colCount(cols) {
+    if (rows <= 0 || cols <= 0) throw std::invalid_argument("GridMap needs at least one row and one column");
+    if (defaultCost < 1 && defaultCost != BLOCKED) throw std::invalid_argument("GridMap costs must be >= 1 or BLOCKED");
+
+    costs.assign(static_cast<std::size_t>(rows) * cols, defaultCost);
+    if (defaultCost != 1 && defaultCost != BLOCKED) weightedCells = rows * cols;
+}
+
+void GridMap::setCost(int row, int col, int cost) {
+    if (!inBounds(row, col)) throw std::out_of_range("GridMap cell out of bounds");
+    if (cost < 1 && cost != BLOCKED) throw std::invalid_argument("GridMap costs must be >= 1 or BLOCKED");
+
+    int& cell = costs[index(row, col)];
+    bool wasWeighted = cell != 1 && cell != BLOCKED;
+    bool isWeighted = cost != 1 && cost != BLOCKED;
+    weightedCells += int(isWeighted) - int(wasWeighted);
+    cell = cost;
+}
+
+Pathfinder::Pathfinder(const GridMap& map) : map(map) {
+    std::size_t cells = static_cast<std::size_t>(map.rows()) * map.cols();
+    gCost.assign(cells, UNREACHED);
+    parent.assign(cells, -1);
+    handles.assign(cells, 0);
+    closed.assign((cells + 63) / 64, 0);
+}
+
+int Pathfinder::octile(int rowDelta, int colDelta) {
+    int a = std::abs(rowDelta);
+    int b = std::abs(colDelta);
+    return STRAIGHT_COST * std::max(a, b) + (DIAGONAL_COST - STRAIGHT_COST) * std::min(a, b);
+}
+
+// A step must land on a passable cell; a diagonal step also needs both cells it passes between
+bool Pathfinder::canStep(int row, int col, int rowStep, int colStep) const {
+    if (!map.passable(row + rowStep, col + colStep)) return false;
+    return rowStep == 0 || colStep == 0 || (map.passable(row + rowStep, col) && map.passable(row, col + colStep));
+}
+
+void Pathfinder::relax(int row, int col, int cost, int from, bool useHeuristic) {
+    int index = map.index(row, col);
+    if (cost >= gCost[index]) return;
+
+    bool queued = gCost[index] != UNREACHED;
+    if (!queued) touched.push_back(index);
+    gCost[index] = cost;
+    parent[index] = from;
+
+    Cell entry{row, col, cost + (useHeuristic ? octile(goalRow - row, goalCol - col) : 0)};
+    // A cell already popped holds a stale handle, so it is pushed again (reopened) instead
+    if (queued && open.contains(handles[index])) {
+        open.decrease_key(handles[index], entry);
+    } else {
+        handles[index] = open.push(entry);
+    }
+}
+
+int Pathfinder::findPath(const Cell& start, const Cell& goal, Algorithm algorithm, std::vector<Cell>& path) {
+    path.clear();
+    expanded = 0;
+    if (!map.passable(start.row, start.col) || !map.passable(goal.row, goal.col)) return NO_PATH;
+
+    goalRow = goal.row;
+    goalCol = goal.col;
+
+    int result;
+    if (algorithm == Algorithm::JumpPoint && map.isUniform()) {
+        result = searchJumpPoint(start);
+    } else {
+        result = search(start, algorithm != Algorithm::Dijkstra);
+    }
+
+    if (result != NO_PATH) buildPath(map.index(goalRow, goalCol), path);
+    reset();
+    return result;
+}
+
+// Dijkstra (no heuristic) or A* (octile heuristic, consistent because every cell costs at least 1)
+int Pathfinder::search(const Cell& start, bool useHeuristic) {
+    static constexpr int ROW_STEPS[] = {-1, 1, 0, 0, -1, -1, 1, 1};
+    static constexpr int COL_STEPS[] = {0, 0, -1, 1, -1, 1, -1, 1};
+
+    int goal = map.index(goalRow, goalCol);
+    relax(start.row, start.col, 0, -1, useHeuristic);
+
+    while (!open.empty()) {
+        Cell cell = open.top();
+        open.pop();
+        int index = map.index(cell.row, cell.col);
+        close(index);
+        ++expanded;
+        if (index == goal) return gCost[index];
+
+        for (int direction = 0; direction < 8; ++direction) {
+            int rowStep = ROW_STEPS[direction];
+            int colStep = COL_STEPS[direction];
+            if (!canStep(cell.row, cell.col, rowStep, colStep)) continue;
+
+            int row = cell.row + rowStep;
+            int col = cell.col + colStep;
+            if (isClosed(map.index(row, col))) continue;
+
+            int step = (rowStep && colStep ? DIAGONAL_COST : STRAIGHT_COST) * map.cost(row, col);
+            relax(row, col, gCost[index] + step, index, useHeuristic);
+        }
+    }
+    return NO_PATH;
+}
+// Complexity: O(n log n) for n reachable cells
+
+// Jump Point Search on a uniform map: instead of queueing every neighbour, scan straight and
+// diagonal lines until a cell with a forced neighbour (or the goal) and queue only those.
+int Pathfinder::searchJumpPoint(const Cell& start) {
+    int goal = map.index(goalRow, goalCol);
+    relax(start.row, start.col, 0, -1, true);
+
+    while (!open.empty()) {
+        Cell cell = open.top();
+        open.pop();
+        int index = map.index(cell.row, cell.col);
+        close(index);
+        ++expanded;
+        if (index == goal) return gCost[index];
+
+        // Directions worth scanning from here, pruned by the direction we arrived from
+        int rowSteps[8];
+        int colSteps[8];
+        int count = 0;
+        auto consider = [&](int rowStep, int colStep) {
+            if (canStep(cell.row, cell.col, rowStep, colStep)) {
+                rowSteps[count] = rowStep;
+                colSteps[count] = colStep;
+                ++count;
+            }
+        };
+
+        if (parent[index] < 0) {
+            for (int rowStep = -1; rowStep <= 1; ++rowStep) {
+                for (int colStep = -1; colStep <= 1; ++colStep) {
+                    if (rowStep || colStep) consider(rowStep, colStep);
+                }
+            }
+        } else {
+            int rowStep = (cell.row > parent[index] / map.cols()) - (cell.row < parent[index] / map.cols());
+            int colStep = (cell.col > parent[index] % map.cols()) - (cell.col < parent[index] % map.cols());
+
+            if (rowStep && colStep) {
+                consider(rowStep, 0);
+                consider(0, colStep);
+                consider(rowStep, colStep);
+            } else {
+                // Perpendicular neighbours may open up behind a wall, so they are always scanned
+                int sideRow = colStep != 0;
+                int sideCol = rowStep != 0;
+                consider(rowStep, colStep);
+                consider(rowStep + sideRow, colStep + sideCol);
+                consider(rowStep - sideRow, colStep - sideCol);
+                consider(sideRow, sideCol);
+                consider(-sideRow, -sideCol);
+            }
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int jumpPoint = jump(cell.row, cell.col, rowSteps[i], colSteps[i]);
+            if (jumpPoint < 0 || isClosed(jumpPoint)) continue;
+
+            int row = jumpPoint / map.cols();
+            int col = jumpPoint % map.cols();
+            relax(row, col, gCost[index] + octile(row - cell.row, col - cell.col), index, true);
+        }
+    }
+    return NO_PATH;
+}
+// Complexity: O(n log n) worst case, usually far fewer queue operations than A*
+
+// Scan from (row, col) in one direction; returns the first jump point or -1 if the scan hits a wall
+int Pathfinder::jump(int row, int col, int rowStep, int colStep) const {
+    if (rowStep == 0 || colStep == 0) return jumpStraight(row, col, rowStep, colStep);
+
+    while (true) {
+        row += rowStep;
+        col += colStep;
+        if (!map.passable(row, col)) return -1;
+        if (row == goalRow && col == goalCol) return map.index(row, col);
+
+        // A diagonal cell is a jump point if either straight scan from it finds one
+        if (jumpStraight(row, col, rowStep, 0) >= 0 || jumpStraight(row, col, 0, colStep) >= 0) {
+            return map.index(row, col);
+        }
+        if (!map.passable(row + rowStep, col) || !map.passable(row, col + colStep)) return -1;
+    }
+}
+
+int Pathfinder::jumpStraight(int row, int col, int rowStep, int colStep) const {
+    int sideRow = colStep != 0;
+    int sideCol = rowStep != 0;
+
+    while (true) {
+        row += rowStep;
+        col += colStep;
+        if (!map.passable(row, col)) return -1;
+        if (row == goalRow && col == goalCol) return map.index(row, col);
+
+        // Forced neighbour: a side cell is open here but was blocked one step back
+        for (int side : {-1, 1}) {
+            int openRow = row + side * sideRow;
+            int openCol = col + side * sideCol;
+            if (map.passable(openRow, openCol) && !map.passable(openRow - rowStep, openCol - colStep)) {
+                return map.index(row, col);
+            }
+        }
+    }
+}
+
+// Walk the parent links back from the goal and expand them into every visited cell. JPS parents
+// are jump points joined by straight or diagonal lines, A* and Dijkstra parents are neighbours.
+void Pathfinder::buildPath(int goal, std::vector<Cell>& path) const {
+    for (int index = goal; index >= 0; index = parent[index]) {
+        path.push_back({index / map.cols(), index % map.cols(), 0});
+    }
+    std::reverse(path.begin(), path.end());
+
+    // Expand in place from the back so unexpanded waypoints are never overwritten
+    std::size_t waypoints = path.size();
+    std::size_t cells = 1;
+    for (std::size_t i = 1; i < waypoints; ++i) {
+        cells += static_cast<std::size_t>(std::max(std::abs(path[i].row - path[i - 1].row), std::abs(path[i].col - path[i - 1].col)));
+    }
+    path.resize(cells);
+
+    std::size_t write = cells;
+    for (std::size_t i = waypoints; i-- > 1;) {
+        Cell to = path[i];
+        Cell from = path[i - 1];
+        int rowStep = (to.row > from.row) - (to.row < from.row);
+        int colStep = (to.col > from.col) - (to.col < from.col);
+        for (Cell cell = to; cell.row != from.row || cell.col != from.col; cell.row -= rowStep, cell.col -= colStep) {
+            path[--write] = {cell.row, cell.col, 0};
+        }
+    }
+
+    // Cumulative costs along the expanded path
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        bool diagonal = path[i].row != path[i - 1].row && path[i].col != path[i - 1].col;
+        path[i].cost = path[i - 1].cost + (diagonal ? DIAGONAL_COST : STRAIGHT_COST) * map.cost(path[i].row, path[i].col);
+    }
+}
+
+void Pathfinder::reset() {
+    for (int index : touched) {
+        gCost[index] = UNREACHED;
+        closed[index >> 6] = 0;
+    }
+    touched.clear();
+    open.clear();
+}
@@ -0,0 +1,105 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_PATHFINDER_H
+#define PROJECT_ESPRIT_MODEL_C_PATHFINDER_H
+
+#include <cstdint>
+#include <vector>
+#include "../data_structures/PriorityQueue.h"
+
+// Row-major grid of movement costs. A cell's cost (>= 1) is paid for every step that enters it;
+// BLOCKED cells cannot be entered.
+class GridMap {
+private:
+    int rowCount;
+    int colCount;
+    std::vector<int> costs;
+    int weightedCells = 0; // Passable cells whose cost differs from 1
+
+public:
+    static constexpr int BLOCKED = -1;
+
+    GridMap(int rows, int cols, int defaultCost = 1);
+
+    int rows() const { return rowCount; }
+    int cols() const { return colCount; }
+    int index(int row, int col) const { return row * colCount + col; }
+
+    bool inBounds(int row, int col) const {
+        return row >= 0 && col >= 0 && row < rowCount && col < colCount;
+    }
+
+    bool passable(int row, int col) const {
+        return inBounds(row, col) && costs[index(row, col)] != BLOCKED;
+    }
+
+    int cost(int row, int col) const { return costs[index(row, col)]; }
+    void setCost(int row, int col, int cost);
+
+    // True when every passable cell costs 1, which Jump Point Search requires
+    bool isUniform() const { return weightedCells == 0; }
+};
+
+// Grid search engine over a GridMap with 8-connected movement: straight steps cost 10 and diagonal
+// steps 14 (times the entered cell's cost), and a diagonal step may not cut the corner of a blocked
+// cell. All search state (costs, parents, open set, closed bitset) is allocated once per map and
+// reset through a list of touched cells, so repeated queries allocate nothing once warmed up.
+// One Pathfinder must not run two queries at the same time.
+class Pathfinder {
+public:
+    enum class Algorithm { Dijkstra, AStar, JumpPoint };
+
+    static constexpr int STRAIGHT_COST = 10;
+    static constexpr int DIAGONAL_COST = 14;
+    static constexpr int NO_PATH = -1;
+
+    explicit Pathfinder(const GridMap& map);
+
+    // Cheapest path from `start` to `goal` (their costs are ignored). On success `path` holds every
+    // cell from start to goal with its cumulative cost and the total cost is returned; otherwise
+    // `path` is empty and NO_PATH is returned. JumpPoint falls back to AStar on non-uniform maps.
+    int findPath(const Cell& start, const Cell& goal, Algorithm algorithm, std::vector<Cell>& path);
+
+    // Cells taken from the open set by the last query
+    std::size_t expandedCells() const { return expanded; }
+
+    // Octile distance in step costs, scaled by the cheapest possible cell cost (1). A lower bound on
+    // the cost of any path covering these deltas, usable as an A* heuristic.
+    static int octile(int rowDelta, int colDelta);
+
+private:
+    using OpenSet = PriorityQueue<Cell>;
+    static constexpr int UNREACHED = INT32_MAX;
+
+    const GridMap& map;
+    std::vector<int> gCost;              // Best known cost from the start, UNREACHED if untouched
+    std::vector<int> parent;             // Predecessor index on the best known path
+    std::vector<OpenSet::Handle> handles; // Open set handle of every cell currently queued
+    std::vector<std::uint64_t> closed;   // One bit per cell
+    std::vector<int> touched;            // Cells whose gCost was set, reset after each query
+    OpenSet open;
+    std::size_t expanded = 0;
+
+    int goalRow = 0;
+    int goalCol = 0;
+
+    bool isClosed(int index) const { return (closed[index >> 6] >> (index & 63)) & 1; }
+    void close(int index) { closed[index >> 6] |= std::uint64_t(1) << (index & 63); }
+
+    bool canStep(int row, int col, int rowStep, int colStep) const;
+
+    // Record `cost` for a cell if it improves on the best known one, queueing or re-keying it
+    void relax(int row, int col, int cost, int from, bool useHeuristic);
+
+    int search(const Cell& start, bool useHeuristic);
+    int searchJumpPoint(const Cell& start);
+    int jump(int row, int col, int rowStep, int colStep) const;
+    int jumpStraight(int row, int col, int rowStep, int colStep) const;
+
+    void buildPath(int goal, std::vector<Cell>& path) const;
+    void reset();
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_PATHFINDER_H
@@ -0,0 +1,143 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#include "TagIndex.h"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <stdexcept>
+
+namespace {
+    bool isKeyword(std::string_view token, std::string_view keyword) {
+        return token.size() == keyword.size() &&
+               std::equal(token.begin(), token.end(), keyword.begin(), [](char a, char b) {
+                   return std::toupper(static_cast<unsigned char>(a)) == b;
+               });
+    }
+
+    // Recursive descent over the tokens of a query:
+    //     or     := and (OR and)*
+    //     and    := factor ((AND)? factor)*
+    //     factor := NOT factor | ( or ) | tag
+    class QueryParser {
+    public:
+        QueryParser(std::string_view expression, const TagIndex& index) : index(index) {
+            std::size_t at = 0;
+            while (at < expression.size()) {
+                char c = expression[at];
+                if (std::isspace(static_cast<unsigned char>(c))) {
+                    ++at;
+                } else if (c == '(' || c == ')') {
+                    tokens.push_back(expression.substr(at++, 1));
+                } else {
+                    std::size_t end = at;
+                    while (end < expression.size() && !std::isspace(static_cast<unsigned char>(expression[end])) &&
+                           expression[end] != '(' && expression[end] != ')') {
+                        ++end;
+                    }
+                    tokens.push_back(expression.substr(at, end - at));
+                    at = end;
+                }
+            }
+        }
+
+        RoaringBitmap parse() {
+            if (tokens.empty()) throw std::invalid_argument("Empty tag query");
+            RoaringBitmap result = parseOr();
+            if (next < tokens.size()) throw std::invalid_argument("Unexpected '" + std::string(tokens[next]) + "' in tag query");
+            return result;
+        }
+
+    private:
+        const TagIndex& index;
+        std::vector<std::string_view> tokens;
+        std::size_t next = 0;
+
+        bool accept(std::string_view keyword) {
+            if (next < tokens.size() && isKeyword(tokens[next], keyword)) {
+                ++next;
+                return true;
+            }
+            return false;
+        }
+
+        bool startsFactor() const {
+            return next < tokens.size() && tokens[next] != ")" && !isKeyword(tokens[next], "AND") &&
+                   !isKeyword(tokens[next], "OR");
+        }
+
+        RoaringBitmap parseOr() {
+            RoaringBitmap result = parseAnd();
+            while (accept("OR")) result = result | parseAnd();
+            return result;
+        }
+
+        RoaringBitmap parseAnd() {
+            RoaringBitmap result = parseFactor();
+            while (true) {
+                if (accept("AND") || startsFactor()) {
+                    // a AND NOT b is a subtraction, with no need to build the complement of b
+                    if (accept("NOT")) {
+                        result = result - parseFactor();
+                    } else {
+                        result = result & parseFactor();
+                    }
+                } else {
+                    return result;
+                }
+            }
+        }
+
+        RoaringBitmap parseFactor() {
+            if (next == tokens.size()) throw std::invalid_argument("Tag query ends too early");
+            if (accept("NOT")) return RoaringBitmap::range(static_cast<std::uint32_t>(index.itemCount())) - parseFactor();
+            if (tokens[next] == "(") {
+                ++next;
+                RoaringBitmap result = parseOr();
+                if (next == tokens.size() || tokens[next] != ")") throw std::invalid_argument("Missing ')' in tag query");
+                ++next;
+                return result;
+            }
+            if (tokens[next] == ")" || isKeyword(tokens[next], "AND") || isKeyword(tokens[next], "OR")) {
+                throw std::invalid_argument("Expected a tag before '" + std::string(tokens[next]) + "'");
+            }
+            return index.postings(tokens[next++]);
+        }
+    };
+}
+
+TagIndex::TagIndex(const ItemStore& store) {
+    for (std::uint32_t id = 0; id < store.tagDictionary().size(); ++id) tags.intern(store.tagDictionary()[id]);
+    build(store.tagColumn(), store.tagWords(), store.size());
+}
+
+TagIndex::TagIndex(const ItemCatalog& catalog) {
+    for (std::uint32_t id = 0; id < catalog.tagCount(); ++id) tags.intern(catalog.tagName(id));
+    build(catalog.tagColumn(), catalog.tagWords(), catalog.size());
+}
+
+// Items are visited in index order, so every posting list is built by appends
+void TagIndex::build(std::span<const std::uint64_t> bits, std::size_t words, std::size_t itemCount) {
+    if (itemCount > UINT32_MAX) throw std::length_error("TagIndex supports at most 2^32 items");
+    items = itemCount;
+    lists.assign(tags.size(), RoaringBitmap());
+    for (std::size_t item = 0; item < itemCount; ++item) {
+        for (std::size_t word = 0; word < words; ++word) {
+            for (std::uint64_t rest = bits[item * words + word]; rest; rest &= rest - 1) {
+                lists[word * 64 + static_cast<std::size_t>(std::countr_zero(rest))].add(static_cast<std::uint32_t>(item));
+            }
+        }
+    }
+}
+// Complexity: O(items * words + tag occurrences)
+
+const RoaringBitmap& TagIndex::postings(std::string_view tag) const {
+    std::uint32_t id = tags.find(tag);
+    return id == StringDictionary::NO_ID ? none : lists[id];
+}
+
+RoaringBitmap TagIndex::query(std::string_view expression) const {
+    return QueryParser(expression, *this).parse();
+}
+// Complexity: O(containers touched by the query's tags, times container work)
@@ -0,0 +1,50 @@
+//
+// Created by Badi on 10/19/2026.
+//
+
+#ifndef PROJECT_ESPRIT_MODEL_C_TAGINDEX_H
+#define PROJECT_ESPRIT_MODEL_C_TAGINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ItemStore.h"
+#include "ItemCatalog.h"
+#include "../data_structures/RoaringBitmap.h"
+
+// Inverted index from tag to the items carrying it. Tags are interned to ids and each id owns a
+// posting list of item indices stored as a RoaringBitmap, so a query touches the items of the
+// tags it names instead of every item, and combines them with bitmap AND/OR/ANDNOT.
+// Queries are boolean expressions over tag names:
+//     weapon AND rare          weapon rare          (adjacent terms are ANDed)
+//     (sword OR axe) AND NOT common
+// AND, OR and NOT are case-insensitive keywords; NOT binds tightest, then AND, then OR.
+class TagIndex {
+public:
+    TagIndex() = default;
+    explicit TagIndex(const ItemStore& store);
+    explicit TagIndex(const ItemCatalog& catalog);
+
+    // Items carrying `tag` (empty if no item does)
+    const RoaringBitmap& postings(std::string_view tag) const;
+
+    // Items matching `expression`; throws invalid_argument for a malformed one
+    RoaringBitmap query(std::string_view expression) const;
+
+    std::size_t itemCount() const { return items; }
+    std::size_t tagCount() const { return tags.size(); }
+
+private:
+    StringDictionary tags;
+    std::vector<RoaringBitmap> lists; // lists[tag id]
+    RoaringBitmap none;
+    std::size_t items = 0;
+
+    // Fill the posting lists from item-major tag bitsets, `words` per item
+    void build(std::span<const std::uint64_t> bits, std::size_t words, std::size_t itemCount);
+};
+
+#endif //PROJECT_ESPRIT_MODEL_C_TAGINDEX_H
@@ -12,6 +12,32 @@
 #include "../data_structures/AVL.h"
 #include "../data_structures/YFastTrie.h"
 #include "../data_structures/MockUpYFastTrie.h"
+#include "../data_structures/YFastTrieSnapshot.h"
+#include "../data_structures/HierarchicalBitset.h"
+#include "../data_structures/BPlusTree.h"
+#include "../data_structures/OrderedIndex.h"
+#include "../data_structures/CompactAVL.h"
+#include "../data_structures/PersistentAVL.h"
+#include "../data_structures/BST.h"
+#include "../data_structures/PriorityQueue.h"
+#include "../data_structures/BucketQueue.h"
+#include "../data_structures/RoaringBitmap.h"
+#include "Pathfinder.h"
+#include "HierarchicalPathfinder.h"
+#include "BatchPathfinder.h"
+#include "FlowField.h"
+#include "ItemStore.h"
+#include "ItemLoader.h"
+#include "ItemCatalog.h"
+#include "TagIndex.h"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <random>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <map>
 #include "Item.h"
 
 // Test function
@@ -235,6 +261,90 @@ void TestAVL() {
     maxKey = avlTree.findMaxKey();
     std::cout << "Maximum key after removals: " << maxKey << "\n";
 
+    // Test 6: Order statistics and range aggregates
+    AVL<int, int, Counted<SumAggregate<int, int>>> prices; // Sums plus sizes for select/rank
+    for (int key = 1; key <= 100; ++key) {
+        prices.insert(key * 2, key); // Keys 2, 4, ..., 200 with values 1 .. 100
+    }
+    prices.remove(100); // Drops value 50
+    prices.insert(4, 10); // Value of key 4 becomes 10
+
+    auto third = prices.select(2);
+    std::cout << "Size: " << prices.size() << " (expected 99)\n";
+    std::cout << "Third smallest key: " << (third ? std::to_string(third->key) : "None") << " (expected 6)\n";
+    std::cout << "Select out of range: " << (prices.select(99) ? "Found" : "None") << " (expected None)\n";
+    std::cout << "Rank of 101: " << prices.rank(101) << " (expected 49)\n";
+    std::cout << "Rank of 104: " << prices.rank(104) << " (expected 50)\n";
+    std::cout << "Sum over [3, 11]: " << prices.aggregate(3, 11) << " (expected 22)\n";
+    std::cout << "Sum over [0, 1000]: " << prices.aggregate(0, 1000) << " (expected 5008)\n";
+    std::cout << "Sum over [7, 7]: " << prices.aggregate(7, 7) << " (expected 0)\n";
+
+    // Test 7: Bulk construction, split and join
+    std::vector<std::pair<int, int>> sorted;
+    for (int key = 0; key < 1000; ++key) sorted.emplace_back(key, key);
+    auto bulk = AVL<int, int, SumAggregate<int, int>>::fromSorted(sorted);
+    auto [below, above] = bulk.split(600);
+    std::cout << "Split at 600: " << below.size() << " + " << above.size() << " keys (expected 600 + 400), source empty: "
+              << (bulk.isEmpty() ? "Yes" : "No") << "\n";
+    std::cout << "Right half minimum: " << above.findMinKey() << " (expected 600)\n";
+
+    auto joined = AVL<int, int, SumAggregate<int, int>>::join(std::move(below), std::move(above));
+    std::cout << "Joined size: " << joined.size() << ", sum: " << joined.aggregate(0, 999) << " (expected 1000, 499500)\n";
+
+    try {
+        auto copy = joined;
+        AVL<int, int, SumAggregate<int, int>>::join(std::move(copy), std::move(joined));
+        std::cout << "Overlapping join: accepted (unexpected)\n";
+    } catch (const std::invalid_argument&) {
+        std::cout << "Overlapping join: rejected\n";
+    }
+
+    // Test 8: Set operations (inputs are consumed, entries of the first tree win on equal keys)
+    auto makeSet = [](int from, int to, int value) {
+        AVL<int, int> set;
+        for (int key = from; key < to; ++key) set.insert(key, value);
+        return set;
+    };
+    auto united = AVL<int, int>::setUnion(makeSet(0, 60, 1), makeSet(40, 100, 2));
+    auto common = AVL<int, int>::setIntersection(makeSet(0, 60, 1), makeSet(40, 100, 2));
+    auto onlyFirst = AVL<int, int>::setDifference(makeSet(0, 60, 1), makeSet(40, 100, 2));
+    std::cout << "Union size: " << united.size() << ", value of 50: " << *united.search(50) << " (expected 100, 1)\n";
+    std::cout << "Intersection: " << common.size() << " keys from " << common.findMinKey() << " to "
+              << common.findMaxKey() << " (expected 20 keys from 40 to 59)\n";
+    std::cout << "Difference: " << onlyFirst.size() << " keys, maximum " << onlyFirst.findMaxKey() << " (expected 40, 39)\n";
+    auto forked = AVL<int, int>::setUnion(makeSet(0, 30000, 1), makeSet(20000, 50000, 2), 3);
+    std::cout << "Forked union size: " << forked.size() << ", value of 25000: " << *forked.search(25000)
+              << " (expected 50000, 1)\n";
+
+    // Test 9: Heights, balance and (when counted) sizes and sums stay exact through random inserts and
+    // removes, both with the early stop (no sizes) and with every ancestor refreshed
+    auto churn = [](auto& tree) {
+        std::mt19937 rng(30);
+        std::map<int, int> reference;
+        bool consistent = true;
+        for (int operation = 0; operation < 20000; ++operation) {
+            int key = static_cast<int>(rng() % 2000);
+            if (rng() % 2) {
+                tree.insert(key, key % 7);
+                reference[key] = key % 7;
+            } else {
+                tree.remove(key);
+                reference.erase(key);
+            }
+            if (operation % 100 == 0) consistent = consistent && tree.isBalanced();
+        }
+        return consistent && tree.isBalanced() && tree.size() == static_cast<int>(reference.size());
+    };
+    AVL<int, int> plainChurn;
+    AVL<int, int, Counted<SumAggregate<int, int>>> countedChurn;
+    bool plainBalanced = churn(plainChurn);
+    bool countedBalanced = churn(countedChurn);
+    int expectedSum = 0;
+    for (int key = 0; key < 2000; ++key) expectedSum += countedChurn.search(key) ? key % 7 : 0;
+    std::cout << "Balanced after random inserts and removes: " << (plainBalanced ? "Yes" : "No") << ", counted "
+              << (countedBalanced && countedChurn.aggregate(0, 1999) == expectedSum ? "Yes" : "No")
+              << " (expected Yes, Yes)\n";
+
     std::cout << "AVL Tree test completed.\n";
 }
 
@@ -261,12 +371,12 @@ void TestYFastTrie() {
     }
 
     auto pred = yFastTrie.predecessor(1);  // Predecessor for a key smaller than all others
-    if (!pred.first) {
+    if (!pred) {
         std::cout << "Empty Trie - Predecessor of key 1: Not Found\n";
     }
 
     auto succ = yFastTrie.successor(1);  // Successor for a key smaller than all others
-    if (!succ.first) {
+    if (!succ) {
         std::cout << "Empty Trie - Successor of key 1: Not Found\n";
     }
 
@@ -276,8 +386,21 @@ void TestYFastTrie() {
     std::cout << "Inserted boundary values into YFastTrie.\n";
 
     succ = yFastTrie.successor(0);
-    if (succ.first) {
-        std::cout << "Successor of 0: Key = " << succ.first << ", Value = " << succ.second << "\n";
+    if (succ) {
+        std::cout << "Successor of 0: Key = " << succ->first << ", Value = " << *succ->second << "\n";
+    }
+
+    pred = yFastTrie.predecessor(5);  // Key 0 is a valid predecessor, not a sentinel
+    if (pred) {
+        std::cout << "Predecessor of 5: Key = " << pred->first << ", Value = " << *pred->second << "\n";
+    }
+
+    // Batched predecessor queries
+    std::vector<int> probes = {13, 6, 11, 0};
+    auto preds = yFastTrie.predecessor_many(probes);
+    for (std::size_t i = 0; i < probes.size(); ++i) {
+        std::cout << "Batched predecessor of " << probes[i] << ": "
+                  << (preds[i] ? "Key = " + std::to_string(preds[i]->first) : "Not Found") << "\n";
     }
 
     // Test 4: Duplicate insertion
@@ -321,5 +444,808 @@ void TestMockYFastTrie() {
     mockYFastTrie.display();
 }
 
+void TestConcurrentYFastTrie() {
+    std::cout << "Testing ConcurrentYFastTrie...\n";
+
+    ConcurrentYFastTrie<int, std::string> trie;
+
+    // Test 1: Insert elements and pin a snapshot
+    trie.insert(10, "Ten");
+    trie.insert(5, "Five");
+    trie.insert(15, "Fifteen");
+    auto before = trie.snapshot();
+    std::cout << "Snapshot epoch " << before.epoch() << " holds " << before.size() << " keys.\n";
+
+    // Test 2: Later writes do not affect the pinned snapshot
+    trie.insert(7, "Seven");
+    trie.remove(15);
+    auto after = trie.snapshot();
+    std::cout << "Old snapshot - Search key 15: " << (before.search(15) ? "Found" : "Not Found") << "\n";
+    std::cout << "New snapshot - Search key 15: " << (after.search(15) ? "Found" : "Not Found") << "\n";
+    std::cout << "Old snapshot - Search key 7: " << (before.search(7) ? "Found" : "Not Found") << "\n";
+    std::cout << "New snapshot - Search key 7: " << (after.search(7) ? "Found" : "Not Found") << "\n";
+
+    // Test 3: Predecessor and successor, including key 0
+    trie.insert(0, "Zero");
+    auto view = trie.snapshot();
+    auto pred = view.predecessor(5);
+    std::cout << "Predecessor of 5: " << (pred ? "Key = " + std::to_string(pred->first) + ", Value = " + *pred->second : "Not Found") << "\n";
+    pred = view.predecessor(0);
+    std::cout << "Predecessor of 0: " << (pred ? "Key = " + std::to_string(pred->first) : "Not Found") << "\n";
+    auto succ = view.successor(7);
+    std::cout << "Successor of 7: " << (succ ? "Key = " + std::to_string(succ->first) + ", Value = " + *succ->second : "Not Found") << "\n";
+    succ = view.successor(10);
+    std::cout << "Successor of 10: " << (succ ? "Key = " + std::to_string(succ->first) : "Not Found") << "\n";
+
+    // Test 4: Readers query while a loader thread keeps inserting
+    std::thread loader([&trie]() {
+        for (int key = 100; key < 2100; ++key) {
+            trie.insert(key, std::to_string(key));
+        }
+    });
+    int consistent = 0;
+    for (int i = 0; i < 200; ++i) {
+        auto current = trie.snapshot();
+        std::size_t counted = 0;
+        auto it = current.successor(-1);
+        while (it) {
+            ++counted;
+            it = current.successor(it->first);
+        }
+        consistent += counted == current.size();
+    }
+    loader.join();
+    std::cout << "Consistent snapshots during concurrent load: " << consistent << "/200\n";
+    std::cout << "Final size: " << trie.size() << "\n";
+
+    // Test 5: Removals merge clusters back together
+    for (int key = 100; key < 2100; ++key) {
+        trie.remove(key);
+    }
+    std::cout << "Size after removals: " << trie.size() << "\n";
+
+    std::cout << "ConcurrentYFastTrie test completed.\n";
+}
+
+void TestHierarchicalBitset() {
+    std::cout << "Testing HierarchicalBitset...\n";
+
+    HierarchicalBitset<16> bitset;
+
+    // Test 1: Insert elements
+    bitset.insert(10);
+    bitset.insert(5);
+    bitset.insert(15);
+    bitset.insert(4095);
+    bitset.insert(0);
+    std::cout << "Inserted " << bitset.size() << " keys into HierarchicalBitset.\n";
+
+    // Test 2: Membership
+    std::cout << "Contains 15: " << (bitset.contains(15) ? "Yes" : "No") << "\n";
+    std::cout << "Contains 16: " << (bitset.contains(16) ? "Yes" : "No") << "\n";
+
+    // Test 3: Predecessor and successor across word and summary boundaries
+    auto pred = bitset.pred(4095);
+    std::cout << "Predecessor of 4095: " << (pred ? std::to_string(*pred) : "Not Found") << "\n";
+    pred = bitset.pred(0);
+    std::cout << "Predecessor of 0: " << (pred ? std::to_string(*pred) : "Not Found") << "\n";
+    auto succ = bitset.succ(15);
+    std::cout << "Successor of 15: " << (succ ? std::to_string(*succ) : "Not Found") << "\n";
+    succ = bitset.succ(4095);
+    std::cout << "Successor of 4095: " << (succ ? std::to_string(*succ) : "Not Found") << "\n";
+
+    // Test 4: Removal clears summaries
+    bitset.remove(4095);
+    succ = bitset.succ(15);
+    std::cout << "Successor of 15 after removing 4095: " << (succ ? std::to_string(*succ) : "Not Found") << "\n";
+    std::cout << "Minimum: " << *bitset.findMin() << ", Maximum: " << *bitset.findMax() << "\n";
+
+    std::cout << "HierarchicalBitset test completed.\n";
+}
+
+void TestBPlusTree() {
+    std::cout << "Testing BPlusTree...\n";
+
+    static_assert(OrderedIndex<BPlusTree<int, std::string>, int, std::string>);
+    static_assert(OrderedIndex<YFastTrie<int, std::string>, int, std::string>);
+
+    BPlusTree<int, std::string> tree;
+
+    // Test 1: Insert enough elements to split leaves and inner nodes
+    for (int key = 0; key < 200; key += 2) {
+        tree.insert(key, std::to_string(key));
+    }
+    tree.insert(10, "Updated Ten");
+    std::cout << "Inserted " << tree.size() << " keys into BPlusTree.\n";
+
+    // Test 2: Search elements
+    auto value = tree.search(10);
+    std::cout << "Search key 10: " << (value ? "Found with value = " + *value : "Not Found") << "\n";
+    value = tree.search(11);
+    std::cout << "Search key 11: " << (value ? "Found with value = " + *value : "Not Found") << "\n";
+
+    // Test 3: Predecessor and successor, including key 0 and the edges
+    auto pred = tree.predecessor(2);
+    std::cout << "Predecessor of 2: " << (pred ? "Key = " + std::to_string(pred->first) : "Not Found") << "\n";
+    pred = tree.predecessor(0);
+    std::cout << "Predecessor of 0: " << (pred ? "Key = " + std::to_string(pred->first) : "Not Found") << "\n";
+    auto succ = tree.successor(101);
+    std::cout << "Successor of 101: " << (succ ? "Key = " + std::to_string(succ->first) : "Not Found") << "\n";
+    succ = tree.successor(198);
+    std::cout << "Successor of 198: " << (succ ? "Key = " + std::to_string(succ->first) : "Not Found") << "\n";
+
+    // Test 4: Batched predecessor queries
+    std::vector<int> probes = {57, 3, 150, 0, 58};
+    auto preds = tree.predecessor_many(probes);
+    for (std::size_t i = 0; i < probes.size(); ++i) {
+        std::cout << "Batched predecessor of " << probes[i] << ": "
+                  << (preds[i] ? "Key = " + std::to_string(preds[i]->first) : "Not Found") << "\n";
+    }
+
+    // Test 5: Removals borrow from and merge siblings
+    for (int key = 0; key < 190; key += 2) {
+        tree.remove(key);
+    }
+    std::cout << "Size after removals: " << tree.size() << "\n";
+    tree.display();
+
+    std::cout << "BPlusTree test completed.\n";
+}
+
+void TestCompactAVL() {
+    std::cout << "Testing CompactAVL...\n";
+
+    static_assert(OrderedIndex<CompactAVL<int, std::string>, int, std::string>);
+
+    CompactAVL<int, std::string> tree;
+
+    // Test 1: Insert elements, including an update
+    for (int key = 0; key < 100; key += 5) {
+        tree.insert(key, std::to_string(key));
+    }
+    tree.insert(10, "Updated Ten");
+    std::cout << "Inserted " << tree.size() << " keys into CompactAVL.\n";
+
+    // Test 2: Search, predecessor and successor
+    auto value = tree.search(10);
+    std::cout << "Search key 10: " << (value ? "Found with value = " + *value : "Not Found") << "\n";
+    value = tree.search(11);
+    std::cout << "Search key 11: " << (value ? "Found with value = " + *value : "Not Found") << "\n";
+    auto pred = tree.predecessor(0);
+    std::cout << "Predecessor of 0: " << (pred ? "Key = " + std::to_string(pred->first) : "Not Found") << "\n";
+    auto succ = tree.successor(42);
+    std::cout << "Successor of 42: " << (succ ? "Key = " + std::to_string(succ->first) : "Not Found") << "\n";
+
+    // Test 3: Removed slots are reused instead of growing the node array
+    std::size_t slots = tree.nodeStorage().size();
+    for (int key = 0; key < 50; key += 5) tree.remove(key);
+    for (int key = 1; key < 50; key += 5) tree.insert(key, std::to_string(key));
+    std::cout << "Size after remove/reinsert: " << tree.size() << ", node slots " << tree.nodeStorage().size()
+              << " (expected 20, " << slots << ")\n";
+    std::cout << "Minimum key: " << tree.findMinKey() << ", maximum key: " << tree.findMaxKey() << "\n";
+
+    // Test 4: Copies are independent
+    CompactAVL<int, std::string> copy = tree;
+    copy.remove(95);
+    std::cout << "Copy size " << copy.size() << ", original size " << tree.size() << " (expected 19, 20)\n";
+
+    std::cout << "CompactAVL test completed.\n";
+}
+
+void TestPersistentAVL() {
+    std::cout << "Testing PersistentAVL...\n";
+
+    // Test 1: Build a version of item prices
+    PersistentAVL<int, int> beforeTick;
+    for (int item = 1; item <= 50; ++item) {
+        beforeTick = beforeTick.insert(item, item * 10);
+    }
+    std::cout << "Prices before tick: " << beforeTick.size() << " items\n";
+
+    // Test 2: A market tick produces a new version; the old one is unchanged
+    PersistentAVL<int, int> snapshot = beforeTick; // O(1)
+    PersistentAVL<int, int> afterTick = beforeTick.insert(7, 75).remove(50).insert(51, 510);
+    std::cout << "Price of item 7: before " << *beforeTick.search(7) << ", after " << *afterTick.search(7)
+              << " (expected 70, 75)\n";
+    std::cout << "Item 50 after tick: " << (afterTick.search(50) ? "Found" : "Not Found")
+              << ", still in snapshot: " << (snapshot.search(50) ? "Yes" : "No") << "\n";
+    std::cout << "Sizes: before " << beforeTick.size() << ", after " << afterTick.size() << "\n";
+
+    // Test 3: Queries on the new version
+    auto pred = afterTick.predecessor(51);
+    auto succ = afterTick.successor(49);
+    std::cout << "Predecessor of 51: " << (pred ? "Key = " + std::to_string(pred->first) : "Not Found") << " (expected 49)\n";
+    std::cout << "Successor of 49: " << (succ ? "Key = " + std::to_string(succ->first) : "Not Found") << " (expected 51)\n";
+
+    // Test 4: Removing a missing key shares the whole tree
+    std::cout << "Removing a missing key shares the root: " << (afterTick.remove(1000).sharesRootWith(afterTick) ? "Yes" : "No") << "\n";
+
+    std::cout << "PersistentAVL test completed.\n";
+}
+
+void TestBST() {
+    std::cout << "Testing BST...\n";
+
+    // Test 1: Sorted inserts stay balanced and iterate in order
+    BST<int> numbers;
+    for (int value = 0; value < 100000; ++value) {
+        numbers.insert(value);
+    }
+    numbers.deleteNode(50);
+    std::cout << "Search 50 after deletion: " << (numbers.search(50) ? "Found" : "Not Found") << "\n";
+    auto it = numbers.lower_bound(49);
+    std::cout << "lower_bound(49) and next: " << *it;
+    ++it;
+    std::cout << ", " << *it << " (expected 49, 51)\n";
+
+    // Test 2: Custom comparator over Item codes, values built in place
+    struct ByCode {
+        bool operator()(const Item& a, const Item& b) const { return a.getCode() < b.getCode(); }
+    };
+    BST<Item, ByCode> items;
+    items.emplace("Sword", 120, 150, std::vector<std::string>{"weapon"}, "Smith", 42, "Available");
+    items.emplace("Shield", 90, 100, std::vector<std::string>{"armor"}, "Smith", 7, "Available");
+    items.insert(Item("Duplicate", 1, 1, {}, "Nobody", 42));
+    std::cout << "Items by code:";
+    for (const Item& item : items) {
+        std::cout << " " << item.getCode() << "=" << item.getName();
+    }
+    std::cout << " (expected 7=Shield 42=Sword)\n";
+
+    // Test 3: Streaming traversal without recursion or printing
+    BST<std::string> words;
+    for (const char* word : {"pear", "apple", "fig"}) words.insert(word);
+    std::vector<std::string> sortedWords;
+    words.copyInOrder(std::back_inserter(sortedWords));
+    std::cout << "Copied in order: " << sortedWords.size() << " words, first " << sortedWords.front() << "\n";
+    std::cout << "In-order traversal: ";
+    words.inorderTraversal();
+    std::size_t totalLength = 0;
+    words.forEachInOrder([&](const std::string& word) { totalLength += word.size(); });
+    std::cout << "Morris walk total length: " << totalLength << ", still "
+              << std::distance(words.begin(), words.end()) << " words (expected 12, 3)\n";
+
+    std::cout << "BST test completed.\n";
+}
+
+void TestPriorityQueue() {
+    std::cout << "Testing PriorityQueue...\n";
+
+    // Test 1: Cells come out cheapest first
+    PriorityQueue<> cells;
+    cells.push({0, 0, 30});
+    auto handle = cells.push({1, 1, 50});
+    cells.push({2, 2, 10});
+    std::cout << "Top cost: " << cells.top().cost << " (expected 10)\n";
+
+    // Test 2: decrease_key moves an element in place instead of pushing a duplicate
+    cells.decrease_key(handle, {1, 1, 5});
+    std::cout << "Top after decrease_key: (" << cells.top().row << ", " << cells.top().col << ") cost "
+              << cells.top().cost << ", size " << cells.size() << " (expected (1, 1) cost 5, size 3)\n";
+    try {
+        cells.decrease_key(handle, {1, 1, 99});
+        std::cout << "Increasing a key: accepted (unexpected)\n";
+    } catch (const std::invalid_argument&) {
+        std::cout << "Increasing a key: rejected\n";
+    }
+    cells.pop();
+    auto recycled = cells.push({3, 3, 40}); // Reuses the popped element's slot
+    try {
+        cells.decrease_key(handle, {1, 1, 1});
+        std::cout << "Stale handle: accepted (unexpected)\n";
+    } catch (const std::out_of_range&) {
+        std::cout << "Stale handle: rejected, recycled handle " << (cells.contains(recycled) ? "live" : "lost")
+                  << " (expected live)\n";
+    }
+
+    // Test 3: push_range heapifies in one pass, then pops in order (8-ary max-heap here)
+    PriorityQueue<int, 8, std::greater<int>> numbers;
+    std::vector<int> values = {5, 1, 9, 3, 7, 2, 8, 6, 4, 0};
+    numbers.push_range(values.begin(), values.end());
+    std::cout << "Popped:";
+    while (!numbers.empty()) {
+        std::cout << " " << numbers.top();
+        numbers.pop();
+    }
+    std::cout << " (expected 9 down to 0)\n";
+
+    std::cout << "PriorityQueue test completed.\n";
+}
+
+void TestHierarchicalPathfinder() {
+    std::cout << "Testing HierarchicalPathfinder...\n";
+
+    // Test 1: A 32x32 map in 8x8 clusters with a long wall open at both ends
+    GridMap map(32, 32);
+    for (int col = 0; col < 30; ++col) map.setCost(15, col, GridMap::BLOCKED);
+    HierarchicalPathfinder hierarchy(map, 8);
+    Pathfinder flat(map);
+    std::vector<Cell> path;
+    std::vector<Cell> waypoints;
+    int cost = hierarchy.findPath({0, 0, 0}, {31, 0, 0}, path);
+    int waypointCost = hierarchy.findWaypoints({0, 0, 0}, {31, 0, 0}, waypoints);
+    int best = flat.findPath({0, 0, 0}, {31, 0, 0}, Pathfinder::Algorithm::AStar, path);
+    std::cout << "Around the wall: cost " << cost << " via " << waypoints.size() - 2 << " portals, flat A* "
+              << best << " (expected a few percent above A*)\n";
+    std::cout << "Waypoint cost matches path cost: " << (cost == waypointCost ? "Yes" : "No") << "\n";
+
+    // Test 2: Closing the gap only rebuilds what changed, and the route switches sides
+    map.setCost(15, 30, GridMap::BLOCKED);
+    map.setCost(15, 31, GridMap::BLOCKED);
+    hierarchy.cellChanged(15, 30);
+    hierarchy.cellChanged(15, 31);
+    hierarchy.refresh();
+    std::cout << "Rebuilt clusters: " << hierarchy.rebuiltClusters() << " of 16 (expected 2)\n";
+    cost = hierarchy.findPath({0, 0, 0}, {31, 0, 0}, path);
+    std::cout << "Sealed wall: " << cost << ", path size " << path.size() << " (expected -1, 0)\n";
+
+    // Test 3: Reopening a gap on the left side brings the route back
+    map.setCost(15, 3, 1);
+    hierarchy.cellChanged(15, 3);
+    cost = hierarchy.findPath({0, 0, 0}, {31, 0, 0}, path);
+    best = flat.findPath({0, 0, 0}, {31, 0, 0}, Pathfinder::Algorithm::AStar, path);
+    std::cout << "Left gap: cost " << cost << ", flat A* " << best << " (expected 334, 334)\n";
+
+    // Test 4: On random costs 1-5 the portals follow the cheap crossings, so a long route stays close to A*
+    GridMap weighted(256, 256);
+    std::mt19937 rng(43);
+    for (int row = 0; row < 256; ++row) {
+        for (int col = 0; col < 256; ++col) weighted.setCost(row, col, 1 + static_cast<int>(rng() % 5));
+    }
+    HierarchicalPathfinder weightedHierarchy(weighted, 32);
+    Pathfinder weightedFlat(weighted);
+    int hierarchyTotal = 0;
+    int flatTotal = 0;
+    for (int row = 0; row < 256; row += 51) {
+        hierarchyTotal += weightedHierarchy.findPath({row, 0, 0}, {255 - row, 255, 0}, path);
+        flatTotal += weightedFlat.findPath({row, 0, 0}, {255 - row, 255, 0}, Pathfinder::Algorithm::AStar, path);
+    }
+    std::cout << "Weighted crossings: " << (hierarchyTotal - flatTotal) * 100 / flatTotal
+              << "% above A* (expected under 5%)\n";
+
+    std::cout << "HierarchicalPathfinder test completed.\n";
+}
+
+void TestBatchPathfinder() {
+    std::cout << "Testing BatchPathfinder...\n";
+
+    // Test 1: A batch on 4 threads gives the same paths as one Pathfinder run serially
+    GridMap map(64, 64);
+    std::mt19937 rng(44);
+    for (int i = 0; i < 600; ++i) map.setCost(static_cast<int>(rng() % 64), static_cast<int>(rng() % 64), GridMap::BLOCKED);
+
+    std::vector<PathRequest> requests;
+    for (int i = 0; i < 100; ++i) {
+        requests.push_back({{static_cast<int>(rng() % 64), static_cast<int>(rng() % 64), 0},
+                            {static_cast<int>(rng() % 64), static_cast<int>(rng() % 64), 0}});
+    }
+
+    BatchPathfinder batch(map, 4);
+    PathBatch results;
+    batch.findPaths(requests, Pathfinder::Algorithm::AStar, results);
+
+    Pathfinder serial(map);
+    std::vector<Cell> path;
+    int mismatches = 0;
+    int unreachable = 0;
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        int cost = serial.findPath(requests[i].start, requests[i].goal, Pathfinder::Algorithm::AStar, path);
+        std::span<const Cell> found = results.path(i);
+        bool same = cost == results.costs[i] && found.size() == path.size() &&
+                    std::equal(found.begin(), found.end(), path.begin(), [](const Cell& a, const Cell& b) {
+                        return a.row == b.row && a.col == b.col && a.cost == b.cost;
+                    });
+        mismatches += !same;
+        unreachable += cost == Pathfinder::NO_PATH;
+    }
+    std::cout << "Threads: " << batch.threadCount() << ", paths: " << results.size() << ", mismatches: " << mismatches
+              << " (expected 4, 100, 0), unreachable: " << unreachable << "\n";
+
+    // Test 2: The pool and result buffers are reused by the next batch
+    requests.resize(10);
+    batch.findPaths(requests, Pathfinder::Algorithm::JumpPoint, results);
+    std::cout << "Second batch paths: " << results.size() << ", cells stored: " << results.cells.size()
+              << ", last offset matches: " << (results.offsets.back() == results.cells.size() ? "Yes" : "No") << "\n";
+
+    std::cout << "BatchPathfinder test completed.\n";
+}
+
+void TestFlowField() {
+    std::cout << "Testing FlowField...\n";
+
+    // Test 1: Distances match Dijkstra and following directions reaches the goal at that cost
+    GridMap map(16, 16);
+    for (int row = 0; row < 12; ++row) map.setCost(row, 8, GridMap::BLOCKED);
+    for (int col = 2; col < 6; ++col) map.setCost(10, col, 5);
+    FlowField field(map);
+    field.build({0, 15, 0});
+
+    Pathfinder pathfinder(map);
+    std::vector<Cell> path;
+    int expected = pathfinder.findPath({0, 0, 0}, {0, 15, 0}, Pathfinder::Algorithm::Dijkstra, path);
+    int row = 0;
+    int col = 0;
+    int walked = 0;
+    while (field.direction(row, col) != FlowField::NONE) {
+        std::uint8_t direction = field.direction(row, col);
+        row += FlowField::ROW_STEP[direction];
+        col += FlowField::COL_STEP[direction];
+        walked += (direction < 4 ? Pathfinder::STRAIGHT_COST : Pathfinder::DIAGONAL_COST) * map.cost(row, col);
+    }
+    std::cout << "Distance from (0, 0): " << field.distance(0, 0) << ", walked " << walked << " to (" << row << ", "
+              << col << "), Dijkstra " << expected << " (expected all equal, ending at (0, 15))\n";
+
+    // Test 2: Opening a gap in the wall only recomputes the cells that get closer
+    map.setCost(2, 8, 1);
+    Cell opened[] = {{2, 8, 0}};
+    field.update(opened);
+    expected = pathfinder.findPath({0, 0, 0}, {0, 15, 0}, Pathfinder::Algorithm::Dijkstra, path);
+    std::cout << "After opening (2, 8): distance " << field.distance(0, 0) << ", Dijkstra " << expected
+              << ", cells settled " << field.updatedCells() << " of 244\n";
+
+    // Test 3: Closing it again restores the detour
+    map.setCost(2, 8, GridMap::BLOCKED);
+    field.update(opened);
+    std::cout << "After closing (2, 8): distance " << field.distance(0, 0) << ", wall cell "
+              << field.distance(2, 8) << " (expected the first distance, -1)\n";
+
+    std::cout << "FlowField test completed.\n";
+}
+
+void TestItemStore() {
+    std::cout << "Testing ItemStore...\n";
+
+    // Test 1: Items round-trip through the columns
+    ItemStore store;
+    store.add(Item("Axe of Regock", 500, 700, {"weapon", "axe", "rare"}, "Vendor_123", 101, "Available"));
+    store.add(Item("Shield of Valor", 300, 500, {"armor", "shield", "common"}, "Vendor_456", 102, "Unavailable"));
+    store.add(Item("Flame Sword", 1200, 1500, {"weapon", "sword", "fire"}, "Vendor_789", 103, "Available"));
+    store.add(Item("Bow of Eternity", 800, 1000, {"weapon", "bow", "legendary"}, "Vendor_123", 104, "Reserved"));
+    store.add(Item("Crystal Shield", 900, 1100, {"armor", "shield", "rare"}, "Vendor_321", 109, "Unavailable"));
+    Item axe = store.toItem(0);
+    std::cout << "Item 0: " << axe.getName() << ", " << axe.getPrice() << ", " << axe.getTags().size() << " tags, "
+              << axe.getVendorName() << ", " << axe.getStatus() << " (expected Axe of Regock, 500, 3 tags, "
+              << "Vendor_123, Available)\n";
+
+    // Test 2: Filters return bitsets that combine
+    ItemSelection cheap;
+    ItemSelection available;
+    store.priceBetween(0, 900, cheap);
+    store.withStatus("Available", available);
+    std::cout << "Price <= 900: " << cheap.count() << " items, Available: " << available.count() << " items";
+    cheap &= available;
+    std::cout << ", both: " << cheap.count() << " (expected 4, 2, 1)\n";
+
+    // Test 3: Tag filters need every tag, and an unknown tag or vendor matches nothing
+    std::string_view wanted[] = {"shield", "rare"};
+    ItemSelection tagged;
+    store.withTags(wanted, tagged);
+    std::cout << "Tagged shield and rare:";
+    for (std::size_t item : tagged.indices()) std::cout << " " << store.name(item);
+    ItemSelection none;
+    store.withVendor("Vendor_000", none);
+    std::cout << " (expected Crystal Shield), unknown vendor: " << none.count() << " (expected 0)\n";
+
+    // Test 4: More than 64 distinct tags widen every item's bitset without losing earlier tags
+    std::vector<std::string> many;
+    for (int i = 0; i < 100; ++i) many.push_back("tag" + std::to_string(i));
+    store.add(Item("Relic", 1, 1, many, "Vendor_001", 200, "Reserved"));
+    std::string_view rare[] = {"rare"};
+    store.withTags(rare, tagged);
+    std::cout << "Tag words: " << store.tagWords() << ", rare items: " << tagged.count() << ", relic has tag99: "
+              << store.hasTag(5, "tag99") << " (expected 2, 2, 1)\n";
+
+    // Test 5: Past 256 statuses an add or append is rejected and leaves no orphan status behind
+    ItemStore full;
+    for (int i = 0; i < 256; ++i) full.add("Item", 1, 1, {}, "Vendor_001", i, "Status" + std::to_string(i));
+    ItemStore extra;
+    extra.add("Extra", 1, 1, {}, "Vendor_001", 999, "Status999");
+    int rejected = 0;
+    try {
+        full.add("Extra", 1, 1, {}, "Vendor_001", 999, "Status999");
+    } catch (const std::length_error&) {
+        ++rejected;
+    }
+    try {
+        full.append(extra);
+    } catch (const std::length_error&) {
+        ++rejected;
+    }
+    std::cout << "Rejected: " << rejected << ", items: " << full.size() << ", statuses: "
+              << full.statusDictionary().size() << " (expected 2, 256, 256)\n";
+
+    std::cout << "ItemStore test completed.\n";
+}
+
+void TestItemLoader() {
+    std::cout << "Testing ItemLoader...\n";
+
+    // Test 1: A mapped file loads like sources/items.txt, with CRLF endings and blank lines ignored
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "esprit_items_test.txt";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "Axe of Regock,500,700,weapon|axe|rare,Vendor_123,101,Available\r\n"
+             << "\n"
+             << "Healing Potion,50,70,potion||healing,Vendor_001,105,Available\n"
+             << "Mystic Ring,400,600,accessory|ring|magic,Vendor_333,111,Reserved";
+    }
+    ItemStore store;
+    loadItems(path.string(), store);
+    std::cout << "Loaded " << store.size() << " items, last status " << store.status(2) << ", potion tags "
+              << store.tags(1).size() << " (expected 3 items, Reserved, 2 tags)\n";
+
+    // Test 2: Malformed rows report their line number
+    const char* broken[] = {"Axe,500,700,weapon,Vendor_123,101,Available\nShield,300,500,armor,Vendor_456,102\n",
+                            "Axe,500,700,weapon,Vendor_123,101,Available\n\nShield,3O0,500,armor,Vendor_456,102,Available\n"};
+    for (const char* text : broken) {
+        try {
+            parseItems(text, store);
+            std::cout << "Malformed row accepted (unexpected)\n";
+        } catch (const std::runtime_error& error) {
+            std::cout << error.what() << "\n";
+        }
+    }
+    std::cout << "(expected a line format error at line 2, then a number error at line 3)\n";
+
+    // Test 3: A missing file throws instead of loading nothing
+    std::filesystem::remove(path);
+    try {
+        loadItems(path.string(), store);
+        std::cout << "Missing file: loaded (unexpected)\n";
+    } catch (const std::runtime_error&) {
+        std::cout << "Missing file: rejected\n";
+    }
+
+    // Test 4: A parallel parse matches the sequential one and numbers errors across chunks
+    std::string text;
+    for (int i = 0; i < 5000; ++i) {
+        text += "Item " + std::to_string(i) + "," + std::to_string(i % 700) + ",0,tag" + std::to_string(i % 90) +
+                "|common,Vendor_" + std::to_string(i % 13) + "," + std::to_string(i) + "," +
+                (i % 3 ? "Available" : "Reserved") + "\n";
+    }
+    ItemStore sequential;
+    ItemStore parallel;
+    parseItems(text, sequential);
+    parseItemsParallel(text, parallel, 4);
+    bool same = sequential.size() == parallel.size();
+    for (std::size_t item = 0; same && item < sequential.size(); ++item) {
+        same = sequential.name(item) == parallel.name(item) && sequential.price(item) == parallel.price(item) &&
+               sequential.vendor(item) == parallel.vendor(item) && sequential.status(item) == parallel.status(item) &&
+               sequential.tags(item) == parallel.tags(item);
+    }
+    std::cout << "Parallel parse of " << text.size() / 1024 << " KB: " << parallel.size() << " items, "
+              << (same ? "same" : "different") << " as sequential (expected 5000, same)\n";
+
+    text.insert(text.find("Item 4320,"), "Broken row\n");
+    try {
+        parseItemsParallel(text, parallel, 4);
+        std::cout << "Malformed row accepted (unexpected)\n";
+    } catch (const std::runtime_error& error) {
+        std::cout << error.what() << " (expected line 4321)\n";
+    }
+
+    std::cout << "ItemLoader test completed.\n";
+}
+
+void TestItemCatalog() {
+    std::cout << "Testing ItemCatalog...\n";
+
+    // Test 1: A converted text catalog reads back through the mapping
+    std::filesystem::path textPath = std::filesystem::temp_directory_path() / "esprit_catalog_test.txt";
+    std::filesystem::path catalogPath = std::filesystem::temp_directory_path() / "esprit_catalog_test.bin";
+    {
+        std::ofstream file(textPath, std::ios::binary);
+        file << "Axe of Regock,500,700,weapon|axe|rare,Vendor_123,101,Available\n"
+             << "Shield of Valor,300,500,armor|shield|common,Vendor_456,102,Unavailable\n"
+             << "Crystal Shield,900,1100,armor|shield|rare,Vendor_321,109,Unavailable\n"
+             << "Mystic Ring,400,600,accessory|ring|magic,Vendor_333,104,Available\n";
+    }
+    ItemCatalog::convert(textPath.string(), catalogPath.string());
+    ItemCatalog catalog(catalogPath.string());
+    Item shield = catalog.toItem(1);
+    std::cout << "Items: " << catalog.size() << ", item 1: " << shield.getName() << ", " << shield.getPrice() << ", "
+              << shield.getVendorName() << ", " << shield.getStatus() << " (expected 4, Shield of Valor, 300, "
+              << "Vendor_456, Unavailable)\n";
+
+    // Test 2: The code index and the filters work straight from the file
+    std::size_t ring = catalog.find(104);
+    std::cout << "Code 104: " << (ring == ItemCatalog::NO_ITEM ? "missing" : std::string(catalog.name(ring)))
+              << ", code 105: " << (catalog.find(105) == ItemCatalog::NO_ITEM ? "missing" : "found")
+              << " (expected Mystic Ring, missing)\n";
+    std::string_view wanted[] = {"shield", "rare"};
+    ItemSelection selection;
+    catalog.withTags(wanted, selection);
+    ItemSelection unavailable;
+    catalog.withStatus("Unavailable", unavailable);
+    std::cout << "Shield and rare: " << selection.count() << ", Unavailable: " << unavailable.count()
+              << " (expected 1, 2)\n";
+
+    // Test 3: A file that is not a catalog is rejected
+    try {
+        ItemCatalog notCatalog(textPath.string());
+        std::cout << "Text file opened as a catalog (unexpected)\n";
+    } catch (const std::runtime_error& error) {
+        std::cout << "Text file rejected: " << error.what() << "\n";
+    }
+
+    // Test 4: A forged tag width whose matrix size would not fit the file is rejected before multiplying
+    std::filesystem::path forgedPath = std::filesystem::temp_directory_path() / "esprit_catalog_forged.bin";
+    {
+        std::ifstream in(catalogPath, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::uint64_t tagWords = bytes.size();
+        std::memcpy(bytes.data() + 24, &tagWords, sizeof(tagWords)); // Header: magic, version, byte order, items, tagWords
+        std::ofstream(forgedPath, std::ios::binary) << bytes;
+    }
+    try {
+        ItemCatalog forged(forgedPath.string());
+        std::cout << "Forged tag width accepted (unexpected)\n";
+    } catch (const std::runtime_error& error) {
+        std::cout << "Forged tag width rejected: " << error.what() << "\n";
+    }
+
+    // Test 5: A forged per-item vendor id opens, but reading it throws instead of indexing past the dictionary
+    {
+        std::ifstream in(catalogPath, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::uint64_t vendorIdsOffset;
+        std::memcpy(&vendorIdsOffset, bytes.data() + 56 + 3 * 16, sizeof(vendorIdsOffset)); // Section entry 3: VendorIds
+        std::uint32_t badVendor = UINT32_MAX;
+        std::memcpy(bytes.data() + vendorIdsOffset, &badVendor, sizeof(badVendor)); // Item 0's vendor id
+        std::ofstream(forgedPath, std::ios::binary | std::ios::trunc) << bytes;
+    }
+    try {
+        ItemCatalog forged(forgedPath.string());
+        std::cout << "Item 1 vendor: " << forged.vendor(1) << " (expected Vendor_456)\n";
+        std::string_view vendor = forged.vendor(0);
+        std::cout << "Forged vendor id read as " << vendor << " (unexpected)\n";
+    } catch (const std::runtime_error& error) {
+        std::cout << "Forged vendor id rejected: " << error.what() << "\n";
+    }
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(catalogPath);
+    std::filesystem::remove(forgedPath);
+
+    std::cout << "ItemCatalog test completed.\n";
+}
+
+void TestRoaringBitmap() {
+    std::cout << "Testing RoaringBitmap...\n";
+
+    // Test 1: Sparse and dense containers side by side
+    RoaringBitmap evens;
+    RoaringBitmap dense;
+    for (std::uint32_t value = 0; value < 200000; value += 2) evens.add(value);
+    for (std::uint32_t value = 100000; value < 110000; ++value) dense.add(value);
+    dense.add(5);
+    std::cout << "Evens: " << evens.cardinality() << ", dense: " << dense.cardinality() << ", contains 99998/99999: "
+              << evens.contains(99998) << evens.contains(99999) << " (expected 100000, 10001, 10)\n";
+
+    // Test 2: AND, OR and AND NOT across container kinds
+    std::cout << "AND: " << (evens & dense).cardinality() << ", OR: " << (evens | dense).cardinality()
+              << ", dense - evens: " << (dense - evens).cardinality() << " (expected 5000, 105001, 5001)\n";
+
+    // Test 3: Out of order adds and the universe range used for NOT
+    RoaringBitmap mixed;
+    for (std::uint32_t value : {70000u, 3u, 70000u, 65536u, 1u}) mixed.add(value);
+    RoaringBitmap complement = RoaringBitmap::range(70001) - mixed;
+    std::cout << "Mixed:";
+    for (std::uint32_t value : mixed.toVector()) std::cout << " " << value;
+    std::cout << ", complement in [0, 70001): " << complement.cardinality() << " (expected 1 3 65536 70000, 69997)\n";
+
+    // Test 4: forEachWhile stops as soon as the visitor returns false
+    std::size_t visited = 0;
+    bool finished = evens.forEachWhile([&](std::uint32_t) { return ++visited < 3; });
+    bool finishedMixed = mixed.forEachWhile([](std::uint32_t) { return true; });
+    std::cout << "Visited: " << visited << ", finished: " << finished << finishedMixed << " (expected 3, 01)\n";
+
+    std::cout << "RoaringBitmap test completed.\n";
+}
+
+void TestTagIndex() {
+    std::cout << "Testing TagIndex...\n";
+
+    ItemStore store;
+    store.add(Item("Axe of Regock", 500, 700, {"weapon", "axe", "rare"}, "Vendor_123", 101, "Available"));
+    store.add(Item("Shield of Valor", 300, 500, {"armor", "shield", "common"}, "Vendor_456", 102, "Unavailable"));
+    store.add(Item("Flame Sword", 1200, 1500, {"weapon", "sword", "fire"}, "Vendor_789", 103, "Available"));
+    store.add(Item("Healing Potion", 50, 70, {"potion", "healing", "rare"}, "Vendor_001", 105, "Available"));
+    store.add(Item("Crystal Shield", 900, 1100, {"armor", "shield", "rare"}, "Vendor_321", 109, "Unavailable"));
+    TagIndex index(store);
+
+    // Test 1: Boolean queries, with implicit AND and precedence NOT > AND > OR
+    const char* queries[] = {"weapon AND rare", "rare NOT armor", "sword OR shield and rare", "(sword or shield) rare",
+                             "NOT rare", "dragon"};
+    for (const char* query : queries) {
+        std::cout << query << ":";
+        index.query(query).forEach([&](std::uint32_t item) { std::cout << " " << store.name(item) << ";"; });
+        std::cout << "\n";
+    }
+    std::cout << "(expected Axe; Axe, Potion; Sword, Crystal Shield; Crystal Shield; Shield of Valor, Sword; nothing)\n";
+
+    // Test 2: Malformed queries are rejected
+    for (const char* query : {"weapon AND", "(weapon OR rare", "OR rare", ""}) {
+        try {
+            index.query(query);
+            std::cout << "'" << query << "' accepted (unexpected)\n";
+        } catch (const std::invalid_argument& error) {
+            std::cout << "'" << query << "' rejected: " << error.what() << "\n";
+        }
+    }
+
+    std::cout << "TagIndex test completed.\n";
+}
+
+void TestBucketQueue() {
+    std::cout << "Testing BucketQueue...\n";
+
+    // Test 1: Cells come out cheapest first, in the same order as PriorityQueue
+    BucketQueue<> cells(4);
+    cells.push({0, 0, 30});
+    cells.push({1, 1, 12});
+    cells.push({2, 2, 20});
+    std::cout << "Top cost: " << cells.top().cost << " (expected 12)\n";
+
+    // Test 2: Keys between the last popped one and the current minimum are still accepted,
+    // and a key far ahead widens the ring (it started with 4 buckets)
+    cells.pop();
+    cells.push({3, 3, 15});
+    cells.push({4, 4, 500});
+    std::cout << "Popped:";
+    while (!cells.empty()) {
+        std::cout << " " << cells.top().cost;
+        cells.pop();
+    }
+    std::cout << " (expected 15 20 30 500)\n";
+
+    // Test 3: A key below the last popped one breaks monotonicity and is rejected
+    cells.push({0, 0, 40});
+    cells.push({0, 0, 45});
+    cells.pop();
+    try {
+        cells.push({0, 0, 39});
+        std::cout << "Key below the last pop: accepted (unexpected)\n";
+    } catch (const std::invalid_argument&) {
+        std::cout << "Key below the last pop: rejected\n";
+    }
+
+    std::cout << "BucketQueue test completed.\n";
+}
+
+void TestPathfinder() {
+    std::cout << "Testing Pathfinder...\n";
+
+    // Test 1: A wall with one gap; every algorithm finds the same cheapest path
+    GridMap map(8, 8);
+    for (int row = 0; row < 8; ++row) {
+        if (row != 6) map.setCost(row, 4, GridMap::BLOCKED);
+    }
+    Pathfinder pathfinder(map);
+    std::vector<Cell> path;
+    const char* names[] = {"Dijkstra", "A*", "JPS"};
+    Pathfinder::Algorithm algorithms[] = {Pathfinder::Algorithm::Dijkstra, Pathfinder::Algorithm::AStar,
+                                          Pathfinder::Algorithm::JumpPoint};
+    for (int i = 0; i < 3; ++i) {
+        int cost = pathfinder.findPath({0, 0, 0}, {0, 7, 0}, algorithms[i], path);
+        std::cout << names[i] << ": cost " << cost << ", " << path.size() << " cells, "
+                  << pathfinder.expandedCells() << " expanded\n";
+    }
+    std::cout << "(expected cost 160 and 15 cells for all three, fewer expansions for A* and JPS)\n";
+
+    // Test 2: Weighted cells are avoided when a detour is cheaper
+    GridMap swamp(3, 5);
+    for (int col = 1; col < 4; ++col) swamp.setCost(1, col, 9);
+    Pathfinder weighted(swamp);
+    int cost = weighted.findPath({1, 0, 0}, {1, 4, 0}, Pathfinder::Algorithm::JumpPoint, path);
+    std::cout << "Swamp detour cost: " << cost << " (expected 48)\n";
+
+    // Test 3: An unreachable goal leaves the path empty
+    map.setCost(6, 4, GridMap::BLOCKED);
+    cost = pathfinder.findPath({0, 0, 0}, {0, 7, 0}, Pathfinder::Algorithm::AStar, path);
+    std::cout << "Sealed wall: " << cost << ", path size " << path.size() << " (expected -1, 0)\n";
+
+    std::cout << "Pathfinder test completed.\n";
+}
+
 
 #endif //PROJECT_ESPRIT_MODEL_C_TESTUNIT_H